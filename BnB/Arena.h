@@ -0,0 +1,84 @@
+#ifndef ARENA_H
+#define ARENA_H
+#include <cstddef>
+#include <vector>
+
+// Reserva objetos de a bloques grandes y los libera todos juntos.
+// Los punteros devueltos no cambian hasta llamar a liberar(), así los nodos
+// del árbol se pueden apuntar entre sí sin copiar nada.
+template <class T>
+class Arena
+{
+public:
+
+    Arena(size_t tam_bloque = 4096);
+    virtual ~Arena();
+
+    T * nuevo(const T & valor);
+    void liberar();
+
+    size_t size() const;
+    size_t bytes() const;
+
+private:
+    std::vector<T *> bloques;
+    size_t tam_bloque;
+    size_t usados; // posiciones ocupadas del último bloque
+    size_t total;
+
+    Arena(const Arena &);
+    Arena & operator =(const Arena &);
+};
+
+template <class T>
+Arena<T>::Arena(size_t tam_bloque)
+{
+    this->tam_bloque=tam_bloque>0 ? tam_bloque : 1;
+    this->usados=this->tam_bloque;
+    this->total=0;
+}
+
+template <class T>
+Arena<T>::~Arena()
+{
+    this->liberar();
+}
+
+template <class T>
+T * Arena<T>::nuevo(const T & valor)
+{
+    if (this->usados==this->tam_bloque)
+    {
+        this->bloques.push_back(new T[this->tam_bloque]);
+        this->usados=0;
+    }
+    T * lugar=this->bloques.back()+this->usados;
+    *lugar=valor;
+    this->usados++;
+    this->total++;
+    return lugar;
+}
+
+template <class T>
+void Arena<T>::liberar()
+{
+    for (size_t i=0; i<this->bloques.size(); i++)
+        delete[] this->bloques[i];
+    this->bloques.clear();
+    this->usados=this->tam_bloque;
+    this->total=0;
+}
+
+template <class T>
+size_t Arena<T>::size() const
+{
+    return this->total;
+}
+
+template <class T>
+size_t Arena<T>::bytes() const
+{
+    return this->bloques.size()*this->tam_bloque*sizeof(T);
+}
+
+#endif // ARENA_H
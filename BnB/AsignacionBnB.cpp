@@ -0,0 +1,343 @@
+#include "AsignacionBnB.h"
+#include "BusquedaLocal.h"
+#include "Hungaro.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <thread>
+
+AsignacionBnB::AsignacionBnB()
+{
+    this->n=0;
+    this->cota_hungaro=false;
+    this->estrategia=MEJOR_PRIMERO;
+    this->memoria_maxima=0;
+    this->reinicios=0;
+    this->cada=0;
+    this->segundos_maximos=0;
+    this->nodos_maximos=0;
+    this->brecha_objetivo=0;
+    this->poda_dominancia=false;
+    this->max_dominancia=0;
+}
+
+AsignacionBnB::~AsignacionBnB() {}
+
+bool AsignacionBnB::cargar(int n, const int * beneficios)
+{
+    if (n<=0 || beneficios==nullptr)
+        return false;
+    this->n=n;
+    this->beneficios.assign(beneficios,beneficios+n*n);
+    this->filas.resize(n);
+    for (int i=0; i<n; i++)
+        this->filas[i]=&this->beneficios[i*n];
+
+    this->sufijo_max.assign((n+1)*n,0);
+    for (int f=n-1; f>=0; f--)
+        for (int d=0; d<n; d++)
+            this->sufijo_max[f*n+d]=std::max(this->getBeneficio(f,d),this->sufijo_max[(f+1)*n+d]);
+
+    // splitmix64 con semilla fija
+    this->zobrist.resize(n);
+    uint64_t x = 0;
+    for (int d=0; d<n; d++)
+    {
+        uint64_t z = (x+=0x9e3779b97f4a7c15ULL);
+        z=(z^(z>>30))*0xbf58476d1ce4e5b9ULL;
+        z=(z^(z>>27))*0x94d049bb133111ebULL;
+        this->zobrist[d]=z^(z>>31);
+    }
+    return true;
+}
+
+void AsignacionBnB::setCotaHungaro(bool usar)
+{
+    this->cota_hungaro=usar;
+}
+
+void AsignacionBnB::setEstrategia(EstrategiaBnB estrategia)
+{
+    this->estrategia=estrategia;
+}
+
+void AsignacionBnB::setMemoriaMaxima(size_t bytes)
+{
+    this->memoria_maxima=bytes;
+}
+
+void AsignacionBnB::setPodaDominancia(bool usar, size_t max_entradas)
+{
+    this->poda_dominancia=usar;
+    this->max_dominancia=max_entradas;
+}
+
+void AsignacionBnB::setReinicios(int reinicios)
+{
+    this->reinicios=reinicios>0 ? reinicios : 0;
+}
+
+void AsignacionBnB::setLimites(double segundos, long long nodos)
+{
+    this->segundos_maximos=segundos;
+    this->nodos_maximos=nodos;
+}
+
+void AsignacionBnB::setBrechaObjetivo(double brecha)
+{
+    this->brecha_objetivo=brecha;
+}
+
+void AsignacionBnB::setProgreso(std::function<void(const EstadisticasBnB &)> progreso, double segundos)
+{
+    this->progreso=progreso;
+    this->cada=segundos;
+}
+
+const EstadisticasBnB & AsignacionBnB::getEstadisticas() const
+{
+    return this->estadisticas;
+}
+
+bool AsignacionBnB::cargar(const std::string & archivo)
+{
+    std::ifstream entrada(archivo.c_str());
+    int n;
+    if (!(entrada>>n) || n<=0)
+        return false;
+    std::vector<int> B(n*n);
+    for (int i=0; i<n*n; i++)
+        if (!(entrada>>B[i]))
+            return false;
+    return this->cargar(n,B.data());
+}
+
+int AsignacionBnB::getSize() const
+{
+    return this->n;
+}
+
+int AsignacionBnB::getBeneficio(int nivel, int decision) const
+{
+    return this->beneficios[nivel*this->n+decision];
+}
+
+int AsignacionBnB::getCotaInicial() const
+{
+    return this->getSolucionInicial(1).getBeneficio();
+}
+
+EstadoAsignacionBnB AsignacionBnB::getEstado(const std::vector<int> & columna) const
+{
+    EstadoAsignacionBnB estado(this->n);
+    for (int i=0; i<this->n; i++)
+        estado.asignar(columna[i],this->filas.data(),this->sufijo_max.data());
+    return estado;
+}
+
+// El reinicio r usa la semilla r, así el resultado no depende de los hilos
+EstadoAsignacionBnB AsignacionBnB::getSolucionInicial(int hilos) const
+{
+    const int * B = this->beneficios.data();
+    std::vector<int> mejor(this->n), columna(this->n);
+    asignacionGolosa(this->n,B,mejor.data());
+    int valor = mejorarPorIntercambios(this->n,B,mejor.data());
+    for (int i=0; i<this->n; i++)
+        columna[i]=i;
+    int valor_diagonal = mejorarPorIntercambios(this->n,B,columna.data());
+    if (valor_diagonal > valor)
+    {
+        valor = valor_diagonal;
+        mejor.swap(columna);
+    }
+
+    if (this->reinicios > 0)
+    {
+        if (hilos <= 0)
+            hilos = std::thread::hardware_concurrency();
+        hilos = std::max(1,std::min(hilos,this->reinicios));
+        std::vector<std::vector<int> > mejor_hilo(hilos,mejor);
+        std::vector<int> valor_hilo(hilos,valor);
+        auto reiniciar = [&](int id)
+        {
+            std::vector<int> perm(this->n);
+            for (int r=id; r<this->reinicios; r+=hilos)
+            {
+                std::mt19937 azar(r);
+                for (int i=0; i<this->n; i++)
+                    perm[i]=i;
+                std::shuffle(perm.begin(),perm.end(),azar);
+                int v = mejorarPorIntercambios(this->n,B,perm.data());
+                if (v > valor_hilo[id])
+                {
+                    valor_hilo[id]=v;
+                    mejor_hilo[id]=perm;
+                }
+            }
+        };
+        std::vector<std::thread> threads;
+        for (int id=1; id<hilos; id++)
+            threads.push_back(std::thread(reiniciar,id));
+        reiniciar(0);
+        for (size_t t=0; t<threads.size(); t++)
+            threads[t].join();
+        for (int id=0; id<hilos; id++)
+            if (valor_hilo[id] > valor)
+            {
+                valor = valor_hilo[id];
+                mejor.swap(mejor_hilo[id]);
+            }
+    }
+    return this->getEstado(mejor);
+}
+
+// Llama encolar(hijo) por cada columna libre. El hijo todavía no está en la
+// arena: lo guarda quien lo encola, si hace falta.
+//
+// Cota de un hijo que asigna la columna c en el nivel f: beneficio acumulado
+// más, para cada otra columna libre, el mejor beneficio que le queda en las
+// filas f+1..n-1. Con T = suma de sufijo_max[f+1][d] sobre las columnas
+// libres del padre, la cota del hijo es beneficio + B[f][c] + T -
+// sufijo_max[f+1][c]: O(n) por expansión y O(1) por hijo.
+template <class F>
+void AsignacionBnB::expandir(const Nodo * e, Auxiliar & aux, F encolar) const
+{
+    const int nivel = e->nivel+1;
+    aux.usadas.assign(this->n,0);
+    for (const NodoAsignacion * a=e; a->nivel>=0; a=a->padre)
+        aux.usadas[a->decision]=1;
+    aux.libres.clear();
+    for (int h=0; h<this->n; h++)
+        if (!aux.usadas[h])
+            aux.libres.push_back(h);
+    if (this->poda_dominancia)
+    {
+        aux.conjunto.assign((this->n+63)/64,0);
+        aux.hash=0;
+        for (int h=0; h<this->n; h++)
+            if (aux.usadas[h])
+            {
+                aux.conjunto[h/64]|=uint64_t(1)<<(h%64);
+                aux.hash^=this->zobrist[h];
+            }
+    }
+
+    const int * resto = &this->sufijo_max[(nivel+1)*this->n];
+    int T = 0;
+    for (size_t i=0; i<aux.libres.size(); i++)
+        T+=resto[aux.libres[i]];
+
+    // Potenciales duales del subproblema filas nivel..n-1 x columnas libres
+    const int k = aux.libres.size();
+    int suma_duales = 0;
+    if (this->cota_hungaro && k > 1)
+    {
+        aux.submatriz.resize(k*k);
+        aux.dual_fila.resize(k);
+        aux.dual_columna.resize(k);
+        for (int i=0; i<k; i++)
+            for (int j=0; j<k; j++)
+                aux.submatriz[i*k+j]=this->getBeneficio(nivel+i,aux.libres[j]);
+        suma_duales=asignacionHungaro(k,aux.submatriz.data(),aux.dual_fila.data(),aux.dual_columna.data());
+    }
+
+    for (int j=0; j<k; j++)
+    {
+        const int h = aux.libres[j];
+        NodoAsignacion hijo;
+        hijo.padre=e;
+        hijo.decision=h;
+        hijo.nivel=nivel;
+        hijo.beneficio=e->beneficio+this->getBeneficio(nivel,h);
+        hijo.cota=hijo.beneficio+T-resto[h];
+        if (this->cota_hungaro && k > 1)
+            hijo.cota=std::min(hijo.cota,hijo.beneficio+suma_duales-aux.dual_fila[0]-aux.dual_columna[j]);
+        encolar(hijo);
+    }
+}
+
+EstadoAsignacionBnB AsignacionBnB::getSolucion(const Nodo * hoja) const
+{
+    std::vector<int> decisiones(this->n);
+    for (const NodoAsignacion * a=hoja; a->nivel>=0; a=a->padre)
+        decisiones[a->nivel]=a->decision;
+    EstadoAsignacionBnB estado(this->n);
+    for (int i=0; i<this->n; i++)
+        estado.asignar(decisiones[i],this->filas.data(),this->sufijo_max.data());
+    return estado;
+}
+
+AsignacionBnB::Nodo AsignacionBnB::raiz() const
+{
+    NodoAsignacion raiz;
+    raiz.padre=nullptr;
+    raiz.decision=-1;
+    raiz.nivel=-1;
+    raiz.beneficio=0;
+    raiz.cota=0;
+    for (int d=0; d<this->n; d++)
+        raiz.cota+=this->sufijo_max[d];
+    return raiz;
+}
+
+int AsignacionBnB::getCota(const Nodo & e) const
+{
+    return e.cota;
+}
+
+int AsignacionBnB::getBeneficio(const Nodo & e) const
+{
+    return e.beneficio;
+}
+
+bool AsignacionBnB::esCompleto(const Nodo & e) const
+{
+    return e.nivel == this->n-1;
+}
+
+// El conjunto de h es el del padre (que dejó expandir en aux) más su columna
+bool AsignacionBnB::dominado(const Nodo & h, Auxiliar & aux) const
+{
+    if (!this->poda_dominancia)
+        return false;
+    const uint64_t bit = uint64_t(1)<<(h.decision%64);
+    aux.conjunto[h.decision/64]|=bit;
+    bool dominado = this->dominancia.dominado(aux.hash^this->zobrist[h.decision],aux.conjunto.data(),h.beneficio);
+    aux.conjunto[h.decision/64]&=~bit;
+    return dominado;
+}
+
+EstadoAsignacionBnB AsignacionBnB::resolver()
+{
+    return this->resolverParalelo(1);
+}
+
+// La incumbente inicial es la del arranque: si nada la mejora es la respuesta.
+EstadoAsignacionBnB AsignacionBnB::resolverParalelo(int hilos)
+{
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    EstadoAsignacionBnB inicial = this->getSolucionInicial(hilos);
+    double restante = this->segundos_maximos;
+    if (restante > 0)
+    {
+        // Si el arranque se comió todo el tiempo se corta enseguida
+        restante-=std::chrono::duration<double>(std::chrono::steady_clock::now()-inicio).count();
+        restante=std::max(restante,1e-9);
+    }
+
+    if (this->poda_dominancia)
+        this->dominancia.iniciar((this->n+63)/64,this->max_dominancia);
+
+    MotorBnB<AsignacionBnB> motor(*this);
+    motor.setEstrategia(this->estrategia);
+    motor.setHilos(hilos);
+    motor.setMemoriaMaxima(this->memoria_maxima);
+    motor.setIncumbente(inicial,inicial.getBeneficio());
+    motor.setLimites(restante,this->nodos_maximos);
+    motor.setBrechaObjetivo(this->brecha_objetivo);
+    motor.setProgreso(this->progreso,this->cada);
+    motor.resolver();
+    this->estadisticas=motor.getEstadisticas();
+    return motor.getSolucion();
+}
@@ -0,0 +1,125 @@
+#ifndef ASIGNACIONBNB_H
+#define ASIGNACIONBNB_H
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "EstadoAsignacionBnB.h"
+#include "MotorBnB.h"
+#include "TablaDominancia.h"
+
+// Nodo compacto del árbol de búsqueda. No guarda la asignación completa:
+// se reconstruye siguiendo los padres (a lo sumo n pasos).
+struct NodoAsignacion
+{
+    const NodoAsignacion * padre;
+    int decision; // columna asignada en este nivel
+    int nivel;
+    int beneficio;
+    int cota;
+};
+
+// Problema de asignación: n niveles (filas) a n decisiones (columnas),
+// maximizando la suma de beneficios B[nivel][decision]. Además de resolverse
+// a sí mismo es el problema que recorre MotorBnB<AsignacionBnB>.
+class AsignacionBnB
+{
+public:
+    typedef NodoAsignacion Nodo;
+    typedef int Valor;
+    typedef EstadoAsignacionBnB Solucion;
+
+    // Auxiliares de expandir, uno por hilo
+    struct Auxiliar
+    {
+        std::vector<char> usadas;
+        std::vector<int> libres;
+        std::vector<int> submatriz;
+        std::vector<int> dual_fila;
+        std::vector<int> dual_columna;
+        std::vector<uint64_t> conjunto; // columnas usadas por el padre, como bitset
+        uint64_t hash;                  // su hash de Zobrist
+    };
+
+    AsignacionBnB();
+    virtual ~AsignacionBnB();
+
+    // Matriz n x n en un buffer contiguo, por filas: B[i][j] = beneficios[i*n+j]
+    bool cargar(int n, const int * beneficios);
+    // Archivo de texto: n y después los n*n beneficios, por filas
+    bool cargar(const std::string & archivo);
+
+    EstadoAsignacionBnB resolver();
+    // Con varios hilos (<= 0: todos los núcleos). Cada hilo tiene su cola,
+    // roba de las demás cuando se queda sin nodos y todos podan con la misma
+    // cota global atómica.
+    EstadoAsignacionBnB resolverParalelo(int hilos);
+
+    // Cota más fuerte: en cada expansión se resuelve con el algoritmo húngaro
+    // lo que falta asignar y se acota a cada hijo con los potenciales duales.
+    // Cuesta O(k^3) por expansión en lugar de O(n).
+    void setCotaHungaro(bool usar);
+    // Por defecto MEJOR_PRIMERO
+    void setEstrategia(EstrategiaBnB estrategia);
+    // Descarta los nodos cuyo conjunto de columnas asignadas ya se vio con un
+    // beneficio mayor o igual: con filas repetidas evita recorrer todas sus
+    // permutaciones. max_entradas acota la tabla (0: sin límite).
+    void setPodaDominancia(bool usar, size_t max_entradas = 0);
+    // Reinicios aleatorios (cada uno seguido de 2-opt) del arranque; 0 por defecto
+    void setReinicios(int reinicios);
+    // Tope en bytes para los nodos guardados (0: sin límite); al llegar se
+    // sigue en profundidad. Ver MotorBnB.
+    void setMemoriaMaxima(size_t bytes);
+
+    int getSize() const;
+    int getBeneficio(int nivel, int decision) const;
+    // Ver MotorBnB::setLimites y setBrechaObjetivo. El tiempo incluye el del
+    // arranque. Si se corta, resolver devuelve la mejor solución hallada y
+    // getEstadisticas la brecha demostrada.
+    void setLimites(double segundos, long long nodos);
+    void setBrechaObjetivo(double brecha);
+    // Ver MotorBnB::setProgreso
+    void setProgreso(std::function<void(const EstadisticasBnB &)> progreso, double segundos);
+    // Las del último resolver
+    const EstadisticasBnB & getEstadisticas() const;
+
+    // Arranque: golosa y diagonal mejoradas con 2-opt, más los reinicios
+    // aleatorios repartidos en hilos (<= 0: todos los núcleos). Es la
+    // incumbente con la que empieza el BnB.
+    EstadoAsignacionBnB getSolucionInicial(int hilos) const;
+    // Beneficio de getSolucionInicial con un hilo
+    int getCotaInicial() const;
+
+    // Lo que pide MotorBnB
+    Nodo raiz() const;
+    template <class F> void expandir(const Nodo * e, Auxiliar & aux, F encolar) const;
+    int getCota(const Nodo & e) const;
+    int getBeneficio(const Nodo & e) const;
+    bool esCompleto(const Nodo & e) const;
+    bool dominado(const Nodo & h, Auxiliar & aux) const;
+    EstadoAsignacionBnB getSolucion(const Nodo * hoja) const;
+
+private:
+    int n;
+    std::vector<int> beneficios; // n*n contiguos
+    std::vector<int *> filas;    // filas[i] = &beneficios[i*n], para asignar(decision, B)
+    std::vector<int> sufijo_max; // (n+1) x n: sufijo_max[f*n+d] = max B[f'][d], f' >= f
+    bool cota_hungaro;
+    EstrategiaBnB estrategia;
+    size_t memoria_maxima;
+    int reinicios;
+    std::function<void(const EstadisticasBnB &)> progreso;
+    double cada;
+    double segundos_maximos;
+    long long nodos_maximos;
+    double brecha_objetivo;
+    EstadisticasBnB estadisticas;
+    bool poda_dominancia;
+    size_t max_dominancia;
+    std::vector<uint64_t> zobrist;      // un número al azar por columna
+    mutable TablaDominancia dominancia; // la llenan los hilos mientras buscan
+
+    EstadoAsignacionBnB getEstado(const std::vector<int> & columna) const;
+};
+
+#endif // ASIGNACIONBNB_H
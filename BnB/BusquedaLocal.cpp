@@ -0,0 +1,53 @@
+#include "BusquedaLocal.h"
+#include <algorithm>
+#include <vector>
+
+int asignacionGolosa(int n, const int * beneficios, int * columna)
+{
+    std::vector<int> orden(n*n);
+    for (int c=0; c<n*n; c++)
+        orden[c]=c;
+    std::sort(orden.begin(),orden.end(),[&](int a, int b)
+    {
+        return beneficios[a] > beneficios[b];
+    });
+
+    std::vector<char> fila_usada(n,0), columna_usada(n,0);
+    int total = 0;
+    for (int c=0, asignadas=0; c<n*n && asignadas<n; c++)
+    {
+        const int i = orden[c]/n, j = orden[c]%n;
+        if (fila_usada[i] || columna_usada[j])
+            continue;
+        fila_usada[i]=columna_usada[j]=1;
+        columna[i]=j;
+        total+=beneficios[orden[c]];
+        asignadas++;
+    }
+    return total;
+}
+
+int mejorarPorIntercambios(int n, const int * beneficios, int * columna)
+{
+    bool mejoro = true;
+    while (mejoro)
+    {
+        mejoro = false;
+        for (int i=0; i<n; i++)
+            for (int j=i+1; j<n; j++)
+            {
+                const int * fi = beneficios+i*n;
+                const int * fj = beneficios+j*n;
+                const int ganancia = fi[columna[j]]+fj[columna[i]]-fi[columna[i]]-fj[columna[j]];
+                if (ganancia > 0)
+                {
+                    std::swap(columna[i],columna[j]);
+                    mejoro = true;
+                }
+            }
+    }
+    int total = 0;
+    for (int i=0; i<n; i++)
+        total+=beneficios[i*n+columna[i]];
+    return total;
+}
@@ -0,0 +1,16 @@
+#ifndef BUSQUEDALOCAL_H
+#define BUSQUEDALOCAL_H
+
+// Heurísticas para arrancar el BnB con una buena incumbente. Trabajan sobre
+// una matriz n x n contigua, por filas, y una permutación columna[i] = columna
+// asignada a la fila i.
+
+// Golosa: recorre los beneficios de mayor a menor y toma cada uno cuya fila y
+// columna estén libres. Devuelve el beneficio total. O(n^2 log n)
+int asignacionGolosa(int n, const int * beneficios, int * columna);
+
+// 2-opt: intercambia las columnas de dos filas mientras alguno de esos
+// intercambios mejore. Devuelve el beneficio total. O(n^2) por pasada
+int mejorarPorIntercambios(int n, const int * beneficios, int * columna);
+
+#endif // BUSQUEDALOCAL_H
@@ -0,0 +1,57 @@
+#include "EstadisticasBnB.h"
+#include <cmath>
+#include <sstream>
+
+EstadisticasBnB::EstadisticasBnB()
+{
+    this->expandidos=0;
+    this->podados=0;
+    this->abiertos=0;
+    this->max_abiertos=0;
+    this->mejoras=0;
+    this->hay_incumbente=false;
+    this->incumbente=0;
+    this->cota=0;
+    this->brecha=0;
+    this->segundos=0;
+    this->segundos_incumbente=-1;
+    this->terminado=false;
+}
+
+// JSON no tiene infinitos ni NaN
+static void escribir(std::ostringstream & salida, double valor, bool definido)
+{
+    if (definido && std::isfinite(valor))
+        salida<<valor;
+    else
+        salida<<"null";
+}
+
+std::string EstadisticasBnB::json() const
+{
+    std::ostringstream salida;
+    salida.precision(12);
+    salida<<"{\"expandidos\":"<<this->expandidos
+          <<",\"podados\":"<<this->podados
+          <<",\"abiertos\":"<<this->abiertos
+          <<",\"max_abiertos\":"<<this->max_abiertos
+          <<",\"mejoras\":"<<this->mejoras
+          <<",\"incumbente\":";
+    escribir(salida,this->incumbente,this->hay_incumbente);
+    salida<<",\"cota\":";
+    escribir(salida,this->cota,true);
+    salida<<",\"brecha\":";
+    escribir(salida,this->brecha,this->hay_incumbente);
+    salida<<",\"segundos\":";
+    escribir(salida,this->segundos,true);
+    salida<<",\"segundos_incumbente\":";
+    escribir(salida,this->segundos_incumbente,this->segundos_incumbente>=0);
+    salida<<",\"terminado\":"<<(this->terminado ? "true" : "false")
+          <<",\"parada\":";
+    if (this->parada.empty())
+        salida<<"null";
+    else
+        salida<<"\""<<this->parada<<"\"";
+    salida<<"}";
+    return salida.str();
+}
@@ -0,0 +1,31 @@
+#ifndef ESTADISTICASBNB_H
+#define ESTADISTICASBNB_H
+#include <string>
+
+// Foto del estado de una búsqueda de MotorBnB. Los valores del problema se
+// pasan a double para no depender de su tipo.
+struct EstadisticasBnB
+{
+    long long expandidos;      // nodos expandidos
+    long long podados;         // nodos descartados por cota
+    long long abiertos;        // nodos encolados o en expansión
+    long long max_abiertos;
+    long long mejoras;         // veces que se mejoró la incumbente
+    bool hay_incumbente;
+    double incumbente;         // beneficio de la mejor solución conocida
+    double cota;               // mayor cota de lo que falta explorar
+    double brecha;             // (cota - incumbente) / |incumbente|
+    double segundos;
+    double segundos_incumbente; // cuándo se encontró la incumbente (< 0: vino de afuera)
+    bool terminado;            // resolver ya volvió
+    // Por qué terminó: "completa" (la incumbente es óptima), "tiempo",
+    // "nodos" o "brecha"; vacío mientras busca
+    std::string parada;
+
+    EstadisticasBnB();
+
+    // Un objeto JSON en una línea; lo que no está definido sale como null
+    std::string json() const;
+};
+
+#endif // ESTADISTICASBNB_H
@@ -1,4 +1,4 @@
-#include "EstadoAsignacionBnB.H"
+#include "EstadoAsignacionBnB.h"
 #define VACIA -1
 
 EstadoAsignacionBnB::EstadoAsignacionBnB(int N)
@@ -30,14 +30,14 @@ EstadoAsignacionBnB::EstadoAsignacionBnB(const EstadoAsignacionBnB & padre)
 
 EstadoAsignacionBnB::~EstadoAsignacionBnB() {}
 
-void EstadoAsignacionBnB::asignar (int decision, int **B)
+void EstadoAsignacionBnB::asignar (int decision, int * const * B)
 {
     this->nivel+=1;
     this->asignacion[decision]=this->nivel;
     this->beneficio_acumulado+=B[this->nivel][decision];
     this->cota_local=this->beneficio_acumulado;
     for (int d=0; d<this->getSize(); d++)
-        if (d!=decision)
+        if (this->asignacion[d]==VACIA)
         {
             int max_=0;
             for (int n=this->nivel + 1; n<this->getSize(); n++)
@@ -49,6 +49,18 @@ void EstadoAsignacionBnB::asignar (int decision, int **B)
         }
 }
 
+void EstadoAsignacionBnB::asignar (int decision, int * const * B, const int * sufijo_max)
+{
+    this->nivel+=1;
+    this->asignacion[decision]=this->nivel;
+    this->beneficio_acumulado+=B[this->nivel][decision];
+    this->cota_local=this->beneficio_acumulado;
+    const int * resto = sufijo_max + (this->nivel+1)*this->getSize();
+    for (int d=0; d<this->getSize(); d++)
+        if (this->asignacion[d]==VACIA)
+            this->cota_local+=resto[d];
+}
+
 unsigned int EstadoAsignacionBnB::getCotaLocal () const
 {
     return this->cota_local;
@@ -105,10 +117,7 @@ EstadoAsignacionBnB& EstadoAsignacionBnB::operator =(const EstadoAsignacionBnB &
         this->nivel=otro.getNivel();
         this->beneficio_acumulado=otro.getBeneficio();
         this->cota_local=otro.getCotaLocal();
-        this->asignacion.insert(this->asignacion.begin(),otro.asignacion.begin(),otro.asignacion.end());
-
-        // for (int i=0;i<otro.getSize();i++)
-        //   this->asignacion[i]=otro.getAsignada(i);
+        this->asignacion=otro.asignacion;
 
     }
     return *this;
@@ -11,7 +11,9 @@ public:
     EstadoAsignacionBnB(const EstadoAsignacionBnB & padre);
     virtual ~EstadoAsignacionBnB();
 
-    void asignar ( int decision, int **B);
+    void asignar ( int decision, int * const * B);
+    // Igual, pero en O(n): sufijo_max[f*n+d] = max B[f'][d] con f'>=f, (n+1) filas
+    void asignar ( int decision, int * const * B, const int * sufijo_max);
 
     unsigned int getCotaLocal () const;
     unsigned int getBeneficio () const;
@@ -0,0 +1,71 @@
+#include "Hungaro.h"
+#include <climits>
+#include <vector>
+
+// Versión con potenciales de minimización sobre costo = -beneficio
+// (filas y columnas numeradas desde 1; la columna 0 es auxiliar).
+int asignacionHungaro(int k, const int * beneficios, int * dual_fila, int * dual_columna)
+{
+    const long long INF = LLONG_MAX/4;
+    std::vector<long long> u(k+1,0), v(k+1,0), minv(k+1);
+    std::vector<int> p(k+1,0), camino(k+1,0);
+    std::vector<char> usada(k+1);
+
+    for (int i=1; i<=k; i++)
+    {
+        p[0]=i;
+        int j0=0;
+        minv.assign(k+1,INF);
+        usada.assign(k+1,0);
+        do
+        {
+            usada[j0]=1;
+            int i0=p[j0], j1=0;
+            long long delta=INF;
+            for (int j=1; j<=k; j++)
+                if (!usada[j])
+                {
+                    long long cur=-(long long)beneficios[(i0-1)*k+j-1]-u[i0]-v[j];
+                    if (cur<minv[j])
+                    {
+                        minv[j]=cur;
+                        camino[j]=j0;
+                    }
+                    if (minv[j]<delta)
+                    {
+                        delta=minv[j];
+                        j1=j;
+                    }
+                }
+            for (int j=0; j<=k; j++)
+                if (usada[j])
+                {
+                    u[p[j]]+=delta;
+                    v[j]-=delta;
+                }
+                else
+                    minv[j]-=delta;
+            j0=j1;
+        }
+        while (p[j0]!=0);
+        do
+        {
+            int j1=camino[j0];
+            p[j0]=p[j1];
+            j0=j1;
+        }
+        while (j0);
+    }
+
+    // u[i] + v[j] <= -B[i][j]  =>  (-u[i]) + (-v[j]) >= B[i][j]
+    long long optimo=0;
+    for (int i=1; i<=k; i++)
+    {
+        if (dual_fila!=nullptr)
+            dual_fila[i-1]=-u[i];
+        if (dual_columna!=nullptr)
+            dual_columna[i-1]=-v[i];
+        optimo+=-u[i]-v[i];
+    }
+    return optimo;
+}
@@ -0,0 +1,13 @@
+#ifndef HUNGARO_H
+#define HUNGARO_H
+
+// Algoritmo húngaro (Kuhn-Munkres) para el problema de asignación de
+// máximo beneficio sobre una matriz k x k contigua, por filas. O(k^3)
+//
+// Además del óptimo deja potenciales duales: dual_fila[i] + dual_columna[j]
+// >= beneficios[i*k+j] para todo i, j, y sus sumas dan el óptimo. Cualquier
+// subconjunto cuadrado de filas y columnas queda acotado por la suma de sus
+// potenciales, que es lo que usa el BnB para acotar a los hijos en O(1).
+int asignacionHungaro(int k, const int * beneficios, int * dual_fila, int * dual_columna);
+
+#endif // HUNGARO_H
@@ -0,0 +1,683 @@
+#ifndef MOTORBNB_H
+#define MOTORBNB_H
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Arena.h"
+#include "EstadisticasBnB.h"
+
+// Orden en que se exploran los nodos vivos
+enum EstrategiaBnB
+{
+    MEJOR_PRIMERO, // siempre el de mayor cota: expande menos nodos, pero guarda muchos
+    PROFUNDIDAD,   // el último generado: llega rápido a las hojas y guarda pocos
+    HIBRIDA        // mejor primero, pero desde cada nodo baja por el mejor hijo hasta podar
+};
+
+// Ramificación y poda genérica, maximizando. P describe el problema:
+//
+//   typedef ... Nodo;      nodo compacto del árbol, el motor lo guarda en una arena
+//   typedef ... Valor;     tipo de beneficios y cotas
+//   typedef ... Solucion;  lo que se conserva de la mejor hoja
+//   typedef ... Auxiliar;  memoria de trabajo de expandir, una por hilo
+//   Nodo raiz() const;
+//   template <class F> void expandir(const Nodo * e, Auxiliar & aux, F encolar) const;
+//       llama encolar(hijo) por cada hijo de *e (los hijos pueden apuntar a e)
+//   Valor getCota(const Nodo & e) const;      cota superior de las hojas debajo de e
+//   Valor getBeneficio(const Nodo & e) const; beneficio de una hoja
+//   bool esCompleto(const Nodo & e) const;    e es una hoja
+//   bool dominado(const Nodo & h, Auxiliar & aux) const;
+//       se llama desde encolar para los hijos que no son hojas y pasaron la
+//       cota; true descarta a h (si no hay reglas de dominancia, false)
+//   Solucion getSolucion(const Nodo * hoja) const;
+//
+// Con varios hilos cada uno tiene su cola y su arena, roba nodos de las colas
+// ajenas cuando se queda sin trabajo y todos podan contra la misma incumbente.
+//
+// Con un presupuesto de memoria (setMemoriaMaxima), el hilo que lo supera
+// deja de guardar nodos: cada nodo que saca de la cola lo recorre entero en
+// profundidad, con los hijos de cada nivel en un vector que se reusa, así que
+// la memoria queda acotada por profundidad x ramificación.
+//
+// Para usarlo con un tiempo de respuesta acotado (setLimites,
+// setBrechaObjetivo) la búsqueda se corta y queda la mejor solución hallada;
+// getEstadisticas da entonces la brecha demostrada contra la mayor cota de lo
+// que quedó sin explorar.
+//
+// Los contadores de las estadísticas los escribe sólo su hilo, sin
+// instrucciones atómicas de lectura-escritura; sin función de progreso el
+// costo es una suma por nodo.
+template <class P>
+class MotorBnB
+{
+public:
+    typedef typename P::Nodo Nodo;
+    typedef typename P::Valor Valor;
+    typedef typename P::Solucion Solucion;
+
+    MotorBnB(const P & problema);
+    virtual ~MotorBnB();
+
+    void setEstrategia(EstrategiaBnB estrategia);
+    // Hilos a usar (<= 0: todos los núcleos)
+    void setHilos(int hilos);
+    // Bytes para arenas y colas, repartidos entre los hilos (0: sin límite)
+    void setMemoriaMaxima(size_t bytes);
+    // Solución conocida de antemano: sólo se buscan hojas mejores que ella
+    void setIncumbente(const Solucion & solucion, Valor valor);
+    // Corta la búsqueda a los tantos segundos o tantos nodos expandidos; 0:
+    // sin límite. Los nodos se miran cada 16 expansiones de cada hilo y el
+    // reloj cada REVISION_SEGUNDOS más o menos, o en cada expansión si
+    // expandir tarda más que eso: el corte llega tarde a lo sumo por una
+    // expansión.
+    void setLimites(double segundos, long long nodos);
+    // Corta cuando (cota - incumbente) / |incumbente| <= brecha (se mira cada
+    // 1024 expansiones); <= 0: busca el óptimo
+    void setBrechaObjetivo(double brecha);
+    // Llama progreso cada tantos segundos durante resolver, desde cualquiera
+    // de los hilos. Una función vacía lo desactiva.
+    void setProgreso(std::function<void(const EstadisticasBnB &)> progreso, double segundos);
+
+    // Devuelve true si hay solución, encontrada o dada con setIncumbente
+    bool resolver();
+
+    bool haySolucion() const;
+    const Solucion & getSolucion() const;
+    Valor getValor() const;
+    // Las del último resolver
+    const EstadisticasBnB & getEstadisticas() const;
+
+private:
+    // La cola guarda sólo (cota, puntero al nodo en la arena)
+    typedef std::pair<Valor, const Nodo *> Vivo;
+
+    // Heap por cota (MEJOR_PRIMERO, HIBRIDA) o pila (PROFUNDIDAD). El dueño
+    // saca el mejor o el último; los ladrones el mejor o el más viejo, que en
+    // profundidad es el de mayor subárbol.
+    struct Cola
+    {
+        std::vector<Vivo> vivos;
+        bool pila;
+
+        static bool menor(const Vivo & p, const Vivo & q) { return p.first < q.first; }
+        void agregar(const Vivo & v);
+        Vivo sacar();
+        Vivo robar();
+    };
+
+    // La arena y los auxiliares son sólo del dueño; la cola tiene candado
+    // porque los demás hilos pueden robarle (los nodos robados siguen viviendo
+    // en la arena original hasta el final).
+    struct Trabajador
+    {
+        std::mutex candado;
+        Cola cola;
+        Arena<Nodo> nodos;
+        typename P::Auxiliar aux;
+        std::vector<Nodo> hijos;
+        std::deque<std::vector<Nodo> > niveles; // hijos por nivel en profundizar
+
+        std::atomic<long long> expandidos;
+        std::atomic<long long> podados;
+        std::atomic<bool> ocupado;       // tiene un nodo sacado de una cola
+        std::atomic<Valor> cota_actual;  // y esta es su cota
+
+        // Cuándo mirar el reloj (sólo el dueño)
+        long long paso_reloj;            // expansiones entre dos miradas
+        long long proxima_mirada;        // valor de expandidos
+        double ultima_mirada;            // segundos
+    };
+
+    // Tiempo buscado entre dos miradas al reloj de un hilo: el intervalo en
+    // expansiones se ajusta para acercarse a esto
+    static constexpr double REVISION_SEGUNDOS = 1e-4;
+    static constexpr long long PASO_RELOJ_MAXIMO = 1024;
+
+    const P & problema;
+    EstrategiaBnB estrategia;
+    int hilos;
+    size_t memoria_maxima;
+
+    std::atomic<Valor> incumbente;
+    std::atomic<long> pendientes; // nodos encolados o en expansión
+    std::mutex candado_solucion;
+    Solucion solucion;
+    bool hay_solucion;
+
+    std::vector<Trabajador> * trabajadores; // los del resolver en curso
+    std::chrono::steady_clock::time_point inicio;
+    std::function<void(const EstadisticasBnB &)> progreso;
+    double cada;
+    std::atomic<double> proximo_reporte;
+    double segundos_maximos;
+    long long nodos_maximos;
+    double brecha_objetivo;
+    std::atomic<bool> detener;
+    std::atomic<const char *> parada;
+    std::atomic<long> max_abiertos;
+    long long mejoras;
+    double segundos_incumbente;
+    EstadisticasBnB estadisticas;
+
+    void trabajar(int id, std::vector<Trabajador> & trabajadores);
+    void procesar(const Nodo * e, Trabajador & propio);
+    void profundizar(const Nodo * e, Trabajador & propio, size_t nivel);
+    bool excedido(const Trabajador & propio) const;
+    void ofrecer(const Nodo & hoja);
+    void contarExpansion(Trabajador & propio);
+    void mirarReloj(Trabajador & propio, long long expandidos);
+    void parar(const char * motivo);
+    EstadisticasBnB medir(bool terminado);
+    double segundos() const;
+
+    static void sumar(std::atomic<long long> & contador, long long k);
+
+    MotorBnB(const MotorBnB &);
+    MotorBnB & operator =(const MotorBnB &);
+};
+
+template <class P>
+void MotorBnB<P>::Cola::agregar(const Vivo & v)
+{
+    this->vivos.push_back(v);
+    if (!this->pila)
+        std::push_heap(this->vivos.begin(),this->vivos.end(),menor);
+}
+
+template <class P>
+typename MotorBnB<P>::Vivo MotorBnB<P>::Cola::sacar()
+{
+    if (!this->pila)
+        std::pop_heap(this->vivos.begin(),this->vivos.end(),menor);
+    Vivo v = this->vivos.back();
+    this->vivos.pop_back();
+    return v;
+}
+
+template <class P>
+typename MotorBnB<P>::Vivo MotorBnB<P>::Cola::robar()
+{
+    if (!this->pila)
+        return this->sacar();
+    Vivo v = this->vivos.front();
+    this->vivos.erase(this->vivos.begin());
+    return v;
+}
+
+template <class P>
+MotorBnB<P>::MotorBnB(const P & problema) : problema(problema)
+{
+    this->estrategia=MEJOR_PRIMERO;
+    this->hilos=1;
+    this->memoria_maxima=0;
+    this->incumbente.store(std::numeric_limits<Valor>::lowest());
+    this->pendientes.store(0);
+    this->hay_solucion=false;
+    this->trabajadores=nullptr;
+    this->cada=0;
+    this->proximo_reporte.store(0);
+    this->max_abiertos.store(0);
+    this->mejoras=0;
+    this->segundos_incumbente=-1;
+    this->segundos_maximos=0;
+    this->nodos_maximos=0;
+    this->brecha_objetivo=0;
+    this->detener.store(false);
+    this->parada.store(nullptr);
+}
+
+template <class P>
+MotorBnB<P>::~MotorBnB() {}
+
+template <class P>
+void MotorBnB<P>::setEstrategia(EstrategiaBnB estrategia)
+{
+    this->estrategia=estrategia;
+}
+
+template <class P>
+void MotorBnB<P>::setHilos(int hilos)
+{
+    if (hilos <= 0)
+        hilos = std::thread::hardware_concurrency();
+    this->hilos=hilos>0 ? hilos : 1;
+}
+
+template <class P>
+void MotorBnB<P>::setMemoriaMaxima(size_t bytes)
+{
+    this->memoria_maxima=bytes;
+}
+
+template <class P>
+void MotorBnB<P>::setIncumbente(const Solucion & solucion, Valor valor)
+{
+    this->solucion=solucion;
+    this->hay_solucion=true;
+    this->incumbente.store(valor);
+}
+
+template <class P>
+void MotorBnB<P>::setLimites(double segundos, long long nodos)
+{
+    this->segundos_maximos=segundos>0 ? segundos : 0;
+    this->nodos_maximos=nodos>0 ? nodos : 0;
+}
+
+template <class P>
+void MotorBnB<P>::setBrechaObjetivo(double brecha)
+{
+    this->brecha_objetivo=brecha;
+}
+
+template <class P>
+void MotorBnB<P>::setProgreso(std::function<void(const EstadisticasBnB &)> progreso, double segundos)
+{
+    this->progreso=progreso;
+    this->cada=segundos;
+}
+
+template <class P>
+const EstadisticasBnB & MotorBnB<P>::getEstadisticas() const
+{
+    return this->estadisticas;
+}
+
+template <class P>
+bool MotorBnB<P>::haySolucion() const
+{
+    return this->hay_solucion;
+}
+
+template <class P>
+const typename MotorBnB<P>::Solucion & MotorBnB<P>::getSolucion() const
+{
+    return this->solucion;
+}
+
+template <class P>
+typename MotorBnB<P>::Valor MotorBnB<P>::getValor() const
+{
+    return this->incumbente.load();
+}
+
+template <class P>
+bool MotorBnB<P>::resolver()
+{
+    this->inicio=std::chrono::steady_clock::now();
+    this->proximo_reporte.store(this->cada);
+    this->mejoras=0;
+    this->detener.store(false);
+    this->parada.store(nullptr);
+
+    std::vector<Trabajador> trabajadores(this->hilos);
+    for (int id=0; id<this->hilos; id++)
+    {
+        trabajadores[id].cola.pila = this->estrategia==PROFUNDIDAD;
+        trabajadores[id].expandidos.store(0);
+        trabajadores[id].podados.store(0);
+        trabajadores[id].ocupado.store(false);
+        trabajadores[id].cota_actual.store(Valor());
+        trabajadores[id].paso_reloj=1;
+        trabajadores[id].proxima_mirada=1;
+        trabajadores[id].ultima_mirada=0;
+    }
+    this->trabajadores=&trabajadores;
+
+    const Nodo raiz = this->problema.raiz();
+    if (this->problema.esCompleto(raiz))
+    {
+        this->ofrecer(raiz);
+        this->parar("completa");
+        this->estadisticas=this->medir(true);
+        this->trabajadores=nullptr;
+        return this->hay_solucion;
+    }
+
+    trabajadores[0].cola.agregar(Vivo(this->problema.getCota(raiz),trabajadores[0].nodos.nuevo(raiz)));
+    this->pendientes.store(1);
+    this->max_abiertos.store(1);
+
+    if (this->hilos == 1)
+        this->trabajar(0,trabajadores);
+    else
+    {
+        std::vector<std::thread> threads;
+        for (int id=0; id<this->hilos; id++)
+            threads.push_back(std::thread(&MotorBnB::trabajar,this,id,std::ref(trabajadores)));
+        for (int id=0; id<this->hilos; id++)
+            threads[id].join();
+    }
+    this->parar("completa");
+    this->estadisticas=this->medir(true);
+    this->trabajadores=nullptr;
+    return this->hay_solucion;
+}
+
+template <class P>
+void MotorBnB<P>::trabajar(int id, std::vector<Trabajador> & trabajadores)
+{
+    Trabajador & propio = trabajadores[id];
+    while (!this->detener.load())
+    {
+        Vivo sacado(Valor(),nullptr);
+        {
+            std::lock_guard<std::mutex> candado(propio.candado);
+            if (!propio.cola.vivos.empty())
+            {
+                // En un heap, si el tope no mejora a la incumbente nada lo hace
+                if (!propio.cola.pila && propio.cola.vivos.front().first <= this->incumbente.load())
+                {
+                    sumar(propio.podados,propio.cola.vivos.size());
+                    this->pendientes-=propio.cola.vivos.size();
+                    propio.cola.vivos.clear();
+                }
+                else
+                    sacado=propio.cola.sacar();
+            }
+        }
+        // Sin trabajo propio: se roba de otro hilo
+        for (size_t i=1; i<trabajadores.size() && sacado.second==nullptr; i++)
+        {
+            Trabajador & victima = trabajadores[(id+i)%trabajadores.size()];
+            std::lock_guard<std::mutex> candado(victima.candado);
+            if (!victima.cola.vivos.empty())
+                sacado=victima.cola.robar();
+        }
+        const Nodo * e = sacado.second;
+        if (e==nullptr)
+        {
+            if (this->pendientes.load()==0)
+                return;
+            std::this_thread::yield();
+            continue;
+        }
+
+        propio.cota_actual.store(sacado.first);
+        propio.ocupado.store(true);
+        this->procesar(e,propio);
+        // Si se cortó a la mitad, su cota sigue contando para la brecha
+        if (!this->detener.load())
+            propio.ocupado.store(false);
+        this->pendientes--;
+    }
+}
+
+// Expande e y encola sus hijos no podados. En HIBRIDA no encola el mejor
+// hijo sino que lo expande enseguida, y así hasta que se poda.
+template <class P>
+void MotorBnB<P>::procesar(const Nodo * e, Trabajador & propio)
+{
+    const P & p = this->problema;
+    std::vector<Nodo> & hijos = propio.hijos;
+    while (e != nullptr && !this->detener.load())
+    {
+        if (p.getCota(*e) <= this->incumbente.load())
+        {
+            sumar(propio.podados,1);
+            break;
+        }
+        propio.cota_actual.store(p.getCota(*e));
+        if (this->excedido(propio))
+        {
+            this->profundizar(e,propio,0);
+            break;
+        }
+        hijos.clear();
+        long long podados = 0;
+        p.expandir(e,propio.aux,[&](const Nodo & h)
+        {
+            if (p.getCota(h) > this->incumbente.load())
+            {
+                if (p.esCompleto(h))
+                    this->ofrecer(h);
+                else if (!p.dominado(h,propio.aux))
+                    hijos.push_back(h);
+                else
+                    podados++;
+            }
+            else
+                podados++;
+        });
+        sumar(propio.podados,podados);
+        this->contarExpansion(propio);
+
+        e = nullptr;
+        if (hijos.empty())
+            break;
+        if (this->estrategia == PROFUNDIDAD)
+            // El de mayor cota queda arriba de la pila
+            std::sort(hijos.begin(),hijos.end(),[&](const Nodo & a, const Nodo & b)
+            {
+                return p.getCota(a) < p.getCota(b);
+            });
+        else if (this->estrategia == HIBRIDA)
+        {
+            size_t mejor = 0;
+            for (size_t i=1; i<hijos.size(); i++)
+                if (p.getCota(hijos[i]) > p.getCota(hijos[mejor]))
+                    mejor=i;
+            std::swap(hijos[mejor],hijos.back());
+            e=propio.nodos.nuevo(hijos.back());
+            hijos.pop_back();
+        }
+
+        const long abiertos = this->pendientes+=hijos.size();
+        long maximo = this->max_abiertos.load();
+        while (abiertos > maximo && !this->max_abiertos.compare_exchange_weak(maximo,abiertos)) {}
+        std::lock_guard<std::mutex> candado(propio.candado);
+        for (size_t i=0; i<hijos.size(); i++)
+            propio.cola.agregar(Vivo(p.getCota(hijos[i]),propio.nodos.nuevo(hijos[i])));
+    }
+}
+
+// Recorre en profundidad el subárbol de e sin tocar la arena ni la cola: los
+// hijos de cada nivel quedan en niveles[nivel] mientras se recorren, y los
+// nodos de abajo apuntan a ellos.
+template <class P>
+void MotorBnB<P>::profundizar(const Nodo * e, Trabajador & propio, size_t nivel)
+{
+    const P & p = this->problema;
+    if (propio.niveles.size() == nivel)
+        propio.niveles.push_back(std::vector<Nodo>());
+    std::vector<Nodo> & hijos = propio.niveles[nivel];
+    hijos.clear();
+    long long podados = 0;
+    p.expandir(e,propio.aux,[&](const Nodo & h)
+    {
+        if (p.getCota(h) > this->incumbente.load())
+        {
+            if (p.esCompleto(h))
+                this->ofrecer(h);
+            else if (!p.dominado(h,propio.aux))
+                hijos.push_back(h);
+            else
+                podados++;
+        }
+        else
+            podados++;
+    });
+    sumar(propio.podados,podados);
+    this->contarExpansion(propio);
+    std::sort(hijos.begin(),hijos.end(),[&](const Nodo & a, const Nodo & b)
+    {
+        return p.getCota(a) > p.getCota(b);
+    });
+    for (size_t i=0; i<hijos.size() && !this->detener.load(); i++)
+    {
+        // Ordenados por cota: el primero que no mejora corta a los demás
+        if (p.getCota(hijos[i]) <= this->incumbente.load())
+        {
+            sumar(propio.podados,hijos.size()-i);
+            break;
+        }
+        this->profundizar(&hijos[i],propio,nivel+1);
+    }
+}
+
+// La cola sólo la agranda su dueño, así que leer su capacidad sin el candado
+// es seguro.
+template <class P>
+bool MotorBnB<P>::excedido(const Trabajador & propio) const
+{
+    if (this->memoria_maxima == 0)
+        return false;
+    size_t usada = propio.nodos.bytes()+propio.cola.vivos.capacity()*sizeof(Vivo);
+    return usada > this->memoria_maxima/this->hilos;
+}
+
+template <class P>
+void MotorBnB<P>::ofrecer(const Nodo & hoja)
+{
+    const Valor beneficio = this->problema.getBeneficio(hoja);
+    if (beneficio <= this->incumbente.load())
+        return;
+    std::lock_guard<std::mutex> candado(this->candado_solucion);
+    if (beneficio > this->incumbente.load())
+    {
+        this->solucion=this->problema.getSolucion(&hoja);
+        this->hay_solucion=true;
+        this->incumbente.store(beneficio);
+        this->mejoras++;
+        this->segundos_incumbente=this->segundos();
+    }
+}
+
+template <class P>
+void MotorBnB<P>::sumar(std::atomic<long long> & contador, long long k)
+{
+    contador.store(contador.load(std::memory_order_relaxed)+k,std::memory_order_relaxed);
+}
+
+template <class P>
+double MotorBnB<P>::segundos() const
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now()-this->inicio).count();
+}
+
+// El límite de tiempo se mira según el paso de cada hilo (mirarReloj), el de
+// nodos cada 16 expansiones y la brecha y el progreso cada 1024; si ya toca
+// informar, el primero que logra mover proximo_reporte es el que informa.
+template <class P>
+void MotorBnB<P>::contarExpansion(Trabajador & propio)
+{
+    sumar(propio.expandidos,1);
+    const long long expandidos = propio.expandidos.load(std::memory_order_relaxed);
+    if (this->segundos_maximos > 0 && expandidos >= propio.proxima_mirada)
+        this->mirarReloj(propio,expandidos);
+    if ((expandidos & 15) != 0)
+        return;
+    if (this->nodos_maximos > 0)
+    {
+        long long total = 0;
+        for (size_t id=0; id<this->trabajadores->size(); id++)
+            total+=(*this->trabajadores)[id].expandidos.load(std::memory_order_relaxed);
+        if (total >= this->nodos_maximos)
+            this->parar("nodos");
+    }
+
+    if ((expandidos & 1023) != 0 || (!this->progreso && this->brecha_objetivo <= 0))
+        return;
+    if (this->brecha_objetivo > 0)
+    {
+        EstadisticasBnB e = this->medir(false);
+        if (e.hay_incumbente && e.brecha <= this->brecha_objetivo)
+            this->parar("brecha");
+    }
+    if (!this->progreso)
+        return;
+    double ahora = this->segundos();
+    double proximo = this->proximo_reporte.load();
+    if (ahora >= proximo && this->proximo_reporte.compare_exchange_strong(proximo,ahora+this->cada))
+        this->progreso(this->medir(false));
+}
+
+// Con nodos baratos mirar el reloj en cada expansión se notaría, y con nodos
+// caros (la cota húngara es O(k^3) por nodo) mirarlo cada 16 deja pasar
+// varios milisegundos del límite. Por eso el paso se recalcula en cada
+// mirada para que entre una y otra pasen unos REVISION_SEGUNDOS: baja de
+// golpe si los nodos se encarecen y sube de a lo sumo el doble.
+template <class P>
+void MotorBnB<P>::mirarReloj(Trabajador & propio, long long expandidos)
+{
+    const double ahora = this->segundos();
+    if (ahora >= this->segundos_maximos)
+        this->parar("tiempo");
+    const double transcurrido = ahora-propio.ultima_mirada;
+    long long paso = 2*propio.paso_reloj;
+    if (2*transcurrido > REVISION_SEGUNDOS)
+        paso = (long long)(propio.paso_reloj*REVISION_SEGUNDOS/transcurrido);
+    propio.paso_reloj = std::max(1LL,std::min(paso,(long long)PASO_RELOJ_MAXIMO));
+    propio.proxima_mirada = expandidos+propio.paso_reloj;
+    propio.ultima_mirada = ahora;
+}
+
+// Se queda con el primer motivo
+template <class P>
+void MotorBnB<P>::parar(const char * motivo)
+{
+    const char * ninguno = nullptr;
+    this->parada.compare_exchange_strong(ninguno,motivo);
+    this->detener.store(true);
+}
+
+// La cota de lo que falta es la mayor entre los topes de las colas y los
+// nodos que se están expandiendo. Mientras se busca es aproximada: un nodo
+// que pasa de una cola a un hilo en el medio de la medición puede no verse.
+template <class P>
+EstadisticasBnB MotorBnB<P>::medir(bool terminado)
+{
+    EstadisticasBnB e;
+    bool hay_abiertos = false;
+    Valor cota = Valor();
+    for (size_t id=0; this->trabajadores!=nullptr && id<this->trabajadores->size(); id++)
+    {
+        Trabajador & t = (*this->trabajadores)[id];
+        e.expandidos+=t.expandidos.load(std::memory_order_relaxed);
+        e.podados+=t.podados.load(std::memory_order_relaxed);
+        std::lock_guard<std::mutex> candado(t.candado);
+        for (size_t i=0; i<t.cola.vivos.size(); i++)
+        {
+            if (!hay_abiertos || t.cola.vivos[i].first > cota)
+                cota=t.cola.vivos[i].first;
+            hay_abiertos=true;
+            if (!t.cola.pila)
+                break; // en un heap el primero es el mayor
+        }
+        if (t.ocupado.load() && (!hay_abiertos || t.cota_actual.load() > cota))
+        {
+            cota=t.cota_actual.load();
+            hay_abiertos=true;
+        }
+    }
+    e.abiertos=this->pendientes.load();
+    e.max_abiertos=this->max_abiertos.load();
+
+    std::lock_guard<std::mutex> candado(this->candado_solucion);
+    e.mejoras=this->mejoras;
+    e.hay_incumbente=this->hay_solucion;
+    e.incumbente=this->hay_solucion ? (double)this->incumbente.load() : 0;
+    e.segundos_incumbente=this->mejoras>0 ? this->segundos_incumbente : -1;
+    // Sin nada abierto (o con todo abierto ya sin chance) la incumbente es óptima
+    if (!hay_abiertos || (this->hay_solucion && cota <= this->incumbente.load()))
+        e.cota=e.incumbente;
+    else
+        e.cota=(double)cota;
+    if (e.hay_incumbente)
+        e.brecha=e.cota==e.incumbente ? 0 : (e.cota-e.incumbente)/std::fabs(e.incumbente);
+    e.segundos=this->segundos();
+    e.terminado=terminado;
+    if (this->parada.load() != nullptr)
+        e.parada=this->parada.load();
+    return e;
+}
+
+#endif // MOTORBNB_H
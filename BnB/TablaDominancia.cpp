@@ -0,0 +1,97 @@
+#include "TablaDominancia.h"
+#include <algorithm>
+
+TablaDominancia::TablaDominancia() : fragmentos(FRAGMENTOS)
+{
+    this->palabras=1;
+    this->max_por_fragmento=0;
+    for (int i=0; i<FRAGMENTOS; i++)
+        this->fragmentos[i].usadas=0;
+}
+
+TablaDominancia::~TablaDominancia() {}
+
+void TablaDominancia::iniciar(int palabras, size_t max_entradas)
+{
+    this->palabras=palabras>0 ? palabras : 1;
+    this->max_por_fragmento=max_entradas==0 ? 0 : std::max<size_t>(1,max_entradas/FRAGMENTOS);
+    for (int i=0; i<FRAGMENTOS; i++)
+    {
+        Fragmento & f = this->fragmentos[i];
+        f.entradas.clear();
+        f.claves.clear();
+        f.usadas=0;
+    }
+}
+
+size_t TablaDominancia::size() const
+{
+    size_t total = 0;
+    for (int i=0; i<FRAGMENTOS; i++)
+        total+=this->fragmentos[i].usadas;
+    return total;
+}
+
+// Los bits bajos eligen el fragmento y los altos el lugar dentro de él
+bool TablaDominancia::dominado(uint64_t hash, const uint64_t * conjunto, int beneficio)
+{
+    Fragmento & f = this->fragmentos[hash%FRAGMENTOS];
+    std::lock_guard<std::mutex> candado(f.candado);
+
+    if (2*(f.usadas+1) > f.entradas.size())
+    {
+        if (this->max_por_fragmento == 0 || f.usadas < this->max_por_fragmento)
+            this->agrandar(f);
+    }
+    if (f.entradas.empty())
+        return false;
+
+    const size_t mascara = f.entradas.size()-1;
+    size_t i = (hash>>6)&mascara;
+    for (size_t probados=0; probados<f.entradas.size(); probados++, i=(i+1)&mascara)
+    {
+        Entrada & e = f.entradas[i];
+        if (!e.ocupada)
+        {
+            // Lleno: no se guarda, y sin la entrada no se puede afirmar nada
+            if (this->max_por_fragmento != 0 && f.usadas >= this->max_por_fragmento)
+                return false;
+            e.hash=hash;
+            e.clave=f.claves.size();
+            e.beneficio=beneficio;
+            e.ocupada=true;
+            f.claves.insert(f.claves.end(),conjunto,conjunto+this->palabras);
+            f.usadas++;
+            return false;
+        }
+        if (e.hash == hash && std::equal(conjunto,conjunto+this->palabras,f.claves.begin()+e.clave))
+        {
+            if (e.beneficio >= beneficio)
+                return true;
+            e.beneficio=beneficio;
+            return false;
+        }
+    }
+    return false;
+}
+
+void TablaDominancia::agrandar(Fragmento & f)
+{
+    std::vector<Entrada> viejas;
+    viejas.swap(f.entradas);
+    Entrada vacia;
+    vacia.hash=0;
+    vacia.clave=0;
+    vacia.beneficio=0;
+    vacia.ocupada=false;
+    f.entradas.assign(viejas.empty() ? 16 : 2*viejas.size(),vacia);
+    const size_t mascara = f.entradas.size()-1;
+    for (size_t k=0; k<viejas.size(); k++)
+        if (viejas[k].ocupada)
+        {
+            size_t i = (viejas[k].hash>>6)&mascara;
+            while (f.entradas[i].ocupada)
+                i=(i+1)&mascara;
+            f.entradas[i]=viejas[k];
+        }
+}
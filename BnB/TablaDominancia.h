@@ -0,0 +1,61 @@
+#ifndef TABLADOMINANCIA_H
+#define TABLADOMINANCIA_H
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Mejor beneficio acumulado visto para cada conjunto de columnas asignadas.
+// Dos nodos con el mismo conjunto están en el mismo nivel y les queda el
+// mismo subproblema, así que el de menor beneficio no puede mejorar al otro.
+//
+// Los conjuntos son bitsets de un largo fijo de palabras; se comparan enteros,
+// el hash sólo elige el lugar. Está partida en fragmentos con su propio
+// candado para que la usen varios hilos a la vez.
+class TablaDominancia
+{
+public:
+
+    TablaDominancia();
+    virtual ~TablaDominancia();
+
+    // Vacía la tabla. max_entradas == 0: sin límite; al llenarse se siguen
+    // consultando y actualizando los conjuntos ya guardados.
+    void iniciar(int palabras, size_t max_entradas);
+
+    // true si el conjunto ya se vio con beneficio >= beneficio. Si no, queda
+    // guardado con este beneficio.
+    bool dominado(uint64_t hash, const uint64_t * conjunto, int beneficio);
+
+    size_t size() const;
+
+private:
+    struct Entrada
+    {
+        uint64_t hash;
+        size_t clave;  // posición del bitset en claves
+        int beneficio;
+        bool ocupada;
+    };
+
+    struct Fragmento
+    {
+        std::mutex candado;
+        std::vector<Entrada> entradas; // direccionamiento abierto, potencia de 2
+        std::vector<uint64_t> claves;
+        size_t usadas;
+    };
+
+    static const int FRAGMENTOS = 64;
+
+    int palabras;
+    size_t max_por_fragmento;
+    std::vector<Fragmento> fragmentos;
+
+    void agrandar(Fragmento & f);
+
+    TablaDominancia(const TablaDominancia &);
+    TablaDominancia & operator =(const TablaDominancia &);
+};
+
+#endif // TABLADOMINANCIA_H
@@ -1,114 +1,47 @@
+#include <cstdlib>
 #include <iostream>
-#include <queue>
-#include <list>
-#include "EstadoAsignacionBnB.h"
+#include <string>
+#include "AsignacionBnB.h"
 #define N 4
 using namespace std;
 
-struct comparator
+void iniciar_beneficios(int * B)
 {
-    bool operator()(EstadoAsignacionBnB &p, EstadoAsignacionBnB &q) const
-    {
-        return p.getCotaLocal() < q.getCotaLocal();
-    }
-};
-
-list <EstadoAsignacionBnB> expandir (const EstadoAsignacionBnB & e, int **B)
-{
-
-    list <EstadoAsignacionBnB> hijos;
-    for (int h=0; h<N; h++)
-    {
-        if (!e.estaAsignada(h))
-        {
-            EstadoAsignacionBnB nuevo(e);
-            nuevo.asignar(h,B);
-            hijos.push_back(nuevo);
-        }
-    }
-    return hijos;
+    int beneficios[N*N] = {25, 40, 30, 10,
+                           40, 35,  5, 50,
+                           15,  5, 50, 40,
+                           10, 35, 40, 30
+                          };
+    for (int i=0; i<N*N; i++)
+        B[i]=beneficios[i];
 }
 
-EstadoAsignacionBnB asignacionBnB(const EstadoAsignacionBnB& inicial,int cota_global,int** B)
+// Uso: main [archivo]. El archivo tiene n y después la matriz n x n por filas.
+int main(int argc, char ** argv)
 {
-    EstadoAsignacionBnB solucion(N);
+    AsignacionBnB problema;
 
-    priority_queue<EstadoAsignacionBnB,vector<EstadoAsignacionBnB>,comparator> vivos;
-    vivos.push(inicial);
-    list <EstadoAsignacionBnB> hijos;
-
-    bool encontre = false;
-
-    while (!vivos.empty() && ! encontre)
+    if (argc > 1)
     {
-
-        EstadoAsignacionBnB en_expansion = vivos.top();
-        vivos.pop();
-
-        if (en_expansion.getCotaLocal() > cota_global || en_expansion.getNivel()==-1)
+        if (!problema.cargar(string(argv[1])))
         {
-
-            hijos = expandir (en_expansion,B);
-
-            for (h: hijos)
-            {
-                int aux_cota = h.getCotaLocal();
-                if (aux_cota  > cota_global )
-                {
-                    if (h.getNivel()  == N-1 )
-                    {
-                        solucion = h;
-                        cota_global = aux_cota;
-                    }
-                    else
-                        vivos.push(h);
-                }
-            }
+            cerr<<"No se pudo leer la matriz de "<<argv[1]<<endl;
+            return 1;
         }
+        // Segundo argumento opcional: cantidad de hilos (0 = todos los núcleos)
+        if (argc > 2)
+            problema.resolverParalelo(atoi(argv[2])).mostrar();
         else
-            encontre = true;
+            problema.resolver().mostrar();
+        cerr<<problema.getEstadisticas().json()<<endl;
+        return 0;
     }
-    return solucion;
-}
-void iniciar_beneficios(int ** B)
-{
-    B[0]=new int[N];
-    B[0][0]=25;
-    B[0][1]=40;
-    B[0][2]=30;
-    B[0][3]=10;
-    B[1]=new int[N];
-    B[1][0]=40;
-    B[1][1]=35;
-    B[1][2]=5;
-    B[1][3]=50;
-    B[2]=new int[N];
-    B[2][0]=15;
-    B[2][1]=5;
-    B[2][2]=50;
-    B[2][3]=40;
-    B[3]=new int[N];
-    B[3][0]=10;
-    B[3][1]=35;
-    B[3][2]=40;
-    B[3][3]=30;
-}
-int getCotaInicial(int **B)
-{
-    int cota_inicial = 0;
-    for (int i=0; i<N; i++)
-        cota_inicial+=B[i][i];
-    return cota_inicial;
-}
-int main()
-{
-    int **B = new int *[N];
-    iniciar_beneficios(B);
 
-    int cota_inicial = getCotaInicial(B);
+    int * B = new int[N*N];
+    iniciar_beneficios(B);
+    problema.cargar(N,B);
 
-    EstadoAsignacionBnB estado_inicial(N);
-    EstadoAsignacionBnB estado_solucion = asignacionBnB(estado_inicial,cota_inicial,B);
+    EstadoAsignacionBnB estado_solucion = problema.resolver();
 
     string * pintas = new string[N];
     pintas[0] = "Porter";
@@ -125,8 +58,6 @@ int main()
 
     delete[] tapas;
     delete[] pintas;
-    for (int i=0; i<N; i++)
-        delete[] B[i];
     delete[] B;
 
     return 0;
@@ -0,0 +1,88 @@
+/****
+ * Floyd-Warshall por bloques sobre una matriz de distancias densa. Lo usan
+ * las dos implementaciones de GrafoPuntero (matriz y lista de adyacencias):
+ * cada una arma la matriz a su manera y después llama floydWarshallBloques.
+ */
+#ifndef CAMINOSMINIMOS_H_
+#define CAMINOSMINIMOS_H_
+
+#include "hilos.hpp"
+#include <algorithm>
+#include <cstddef>
+
+using namespace std;
+
+#define FW_BLOQUE 64 // lado de bloque: tres bloques de 64x64 entran en cache
+
+/**
+ * @brief Relaja el bloque de filas [i0, i0+FW_BLOQUE) y columnas
+ * [j0, j0+FW_BLOQUE) usando como intermedios los vértices [k0, k0+FW_BLOQUE):
+ * dist[i][j] = min(dist[i][j], dist[i][k] + dist[k][j]).
+ * El bucle interno recorre dos filas contiguas sin dependencias entre
+ * iteraciones, por eso se marca omp simd para que se vectorice.
+ * @param infinito Valor usado para "no hay camino". Nunca se le suma nada:
+ * una distancia es infinito si y sólo si no hay camino, sin umbrales.
+ */
+template <class D>
+inline void relajarBloque(D *dist, int n, int i0, int j0, int k0, D infinito) {
+  typedef decltype(D() + D()) Suma; // char + char no desborda en int
+  const int iFin = min(n, i0 + FW_BLOQUE);
+  const int jFin = min(n, j0 + FW_BLOQUE);
+  const int kFin = min(n, k0 + FW_BLOQUE);
+  for (int k = k0; k < kFin; k++) {
+    const D *filaK = dist + (size_t)k * n;
+    for (int i = i0; i < iFin; i++) {
+      D *fila = dist + (size_t)i * n;
+      const D dik = fila[k];
+      if (!(dik < infinito))
+        continue;
+#pragma omp simd
+      for (int j = j0; j < jFin; j++) {
+        const D dkj = filaK[j];
+        const Suma candidato = dkj == infinito ? (Suma)infinito : dik + dkj;
+        fila[j] = candidato < fila[j] ? (D)candidato : fila[j];
+      }
+    }
+  }
+}
+
+/**
+ * @brief Caminos mínimos entre todos los pares sobre dist (n x n, por filas,
+ * con infinito donde no hay arco y la diagonal ya en 0). Al terminar
+ * dist[i][j] == infinito exactamente cuando j no se alcanza desde i; los
+ * caminos que existen tienen que costar menos que infinito. La matriz se parte
+ * en bloques de FW_BLOQUE x FW_BLOQUE y para cada bloque k se relaja primero
+ * el bloque diagonal, después la fila y la columna k, y por último el resto.
+ * Las fases 2 y 3 se reparten entre hilos porque sus bloques son
+ * independientes.
+ * @param nHilos Hilos a usar (<= 0: todos los núcleos).
+ * @complexity O(n^3 / nHilos)
+ */
+template <class D>
+void floydWarshallBloques(D *dist, int n, D infinito, int nHilos) {
+  const int nb = (n + FW_BLOQUE - 1) / FW_BLOQUE;
+  for (int kb = 0; kb < nb; kb++) {
+    const int k0 = kb * FW_BLOQUE;
+    relajarBloque(dist, n, k0, k0, k0, infinito);
+
+    // Fase 2: bloques de la fila y la columna kb
+    paraCadaPorcion(nb, nHilos, [&](int, size_t inicio, size_t fin) {
+      for (size_t b = inicio; b < fin; b++)
+        if ((int)b != kb) {
+          relajarBloque(dist, n, k0, (int)b * FW_BLOQUE, k0, infinito);
+          relajarBloque(dist, n, (int)b * FW_BLOQUE, k0, k0, infinito);
+        }
+    });
+
+    // Fase 3: el resto, por franjas de filas
+    paraCadaPorcion(nb, nHilos, [&](int, size_t inicio, size_t fin) {
+      for (size_t bi = inicio; bi < fin; bi++)
+        for (int bj = 0; bj < nb; bj++)
+          if ((int)bi != kb && bj != kb)
+            relajarBloque(dist, n, (int)bi * FW_BLOQUE, bj * FW_BLOQUE, k0,
+                          infinito);
+    });
+  }
+}
+
+#endif /* CAMINOSMINIMOS_H_ */
@@ -0,0 +1,175 @@
+/****
+ * Componentes conexas de grafos no dirigidos usando union-find.
+ *
+ * - componentesConexas: procesa todos los arcos en paralelo con un
+ *   union-find sin locks y devuelve el número de componente de cada vértice.
+ * - ComponentesIncrementales: mantiene las componentes al día a medida que
+ *   se agregan arcos con addArco.
+ *
+ * Si el grafo es dirigido, los arcos se toman sin orientación (componentes
+ * débilmente conexas).
+ */
+#ifndef COMPONENTES_H_
+#define COMPONENTES_H_
+
+#include "mapa/Grafo.hpp"
+#include "hilos.hpp"
+#include "unionFind.hpp"
+#include <map>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Componentes conexas sobre vértices numerados 0..n-1.
+ * Cada hilo une los arcos de una porción contigua del arreglo, compartiendo
+ * el mismo UnionFindConcurrente. O((n + m) α(n) / nHilos) esperado.
+ * @param n Cantidad de vértices.
+ * @param arcos Arcos (origen, destino) con índices en [0, n).
+ * @param nHilos Hilos a usar (<= 0: todos los núcleos).
+ * @return componente[i] en [0, k), numeradas en orden de primera aparición.
+ */
+inline vector<int> componentesConexas(int n, const vector<pair<int, int>> &arcos,
+                                      int nHilos = 0) {
+  UnionFindConcurrente conjuntos(n);
+
+  paraCadaPorcion(arcos.size(), nHilos,
+                  [&conjuntos, &arcos](int, size_t inicio, size_t fin) {
+                    for (size_t i = inicio; i < fin; i++)
+                      conjuntos.unir(arcos[i].first, arcos[i].second);
+                  });
+
+  // Las raíces quedan fijas: se renumeran de 0 a k-1.
+  vector<int> componente(n, -1);
+  vector<int> numero(n, -1);
+  int k = 0;
+  for (int i = 0; i < n; i++) {
+    int raiz = conjuntos.buscar(i);
+    if (numero[raiz] == -1)
+      numero[raiz] = k++;
+    componente[i] = numero[raiz];
+  }
+  return componente;
+}
+
+/**
+ * @brief Componentes conexas de un Grafo<V>.
+ * Indexa los vértices, arma el arreglo de arcos (cada arista no dirigida una
+ * sola vez) y delega en la versión numerada.
+ * @return Mapa vértice -> número de componente en [0, k).
+ */
+template <class V>
+map<V, int> componentesConexas(const Grafo<V> &g, int nHilos = 0) {
+  set<V> vertices = g.getVertices();
+  map<V, int> indice;
+  vector<V> etiqueta;
+  for (typename set<V>::const_iterator v = vertices.begin();
+       v != vertices.end(); v++) {
+    indice.insert({*v, etiqueta.size()});
+    etiqueta.push_back(*v);
+  }
+
+  vector<pair<int, int>> arcos;
+  for (size_t i = 0; i < etiqueta.size(); i++) {
+    set<V> ady = g.getAdyacentes(etiqueta[i]);
+    for (typename set<V>::const_iterator u = ady.begin(); u != ady.end();
+         u++) {
+      int j = indice[*u];
+      // En no dirigidos cada arista aparece dos veces: nos quedamos con i < j
+      if ((int)i < j || !g.hayArco(*u, etiqueta[i]))
+        arcos.push_back({i, j});
+    }
+  }
+
+  vector<int> numeros = componentesConexas(etiqueta.size(), arcos, nHilos);
+  map<V, int> componente;
+  for (size_t i = 0; i < etiqueta.size(); i++)
+    componente.insert({etiqueta[i], numeros[i]});
+  return componente;
+}
+
+/**
+ * Componentes que se actualizan al agregar arcos.
+ * Envuelve al grafo: los arcos se agregan con ComponentesIncrementales::addArco
+ * (que a su vez llama a Grafo::addArco) para que los conjuntos no queden
+ * desactualizados.
+ */
+template <class V> class ComponentesIncrementales {
+public:
+  /**
+   * @brief Indexa los vértices y arcos que ya tiene el grafo. O((n+m) log n)
+   */
+  ComponentesIncrementales(Grafo<V> &g) : grafo(g) {
+    set<V> vertices = g.getVertices();
+    for (typename set<V>::const_iterator v = vertices.begin();
+         v != vertices.end(); v++)
+      this->getIndice(*v);
+    for (typename set<V>::const_iterator v = vertices.begin();
+         v != vertices.end(); v++) {
+      set<V> ady = g.getAdyacentes(*v);
+      for (typename set<V>::const_iterator u = ady.begin(); u != ady.end();
+           u++)
+        this->conjuntos.unir(this->getIndice(*v), this->getIndice(*u));
+    }
+  }
+
+  /**
+   * @brief Agrega el vértice al grafo como componente nueva. O(log n)
+   */
+  void addVertice(const V &v) {
+    this->grafo.addVertice(v);
+    this->getIndice(v);
+  }
+
+  /**
+   * @brief Agrega el arco al grafo y une las componentes de sus extremos.
+   * O(log n) + O(α(n)) amortizado.
+   */
+  void addArco(const V &u, const V &v) {
+    this->grafo.addArco(u, v);
+    this->conjuntos.unir(this->getIndice(u), this->getIndice(v));
+  }
+
+  /**
+   * @brief true si u y v están en la misma componente.
+   */
+  bool conectados(const V &u, const V &v) {
+    typename map<V, int>::const_iterator iU = this->indices.find(u);
+    typename map<V, int>::const_iterator iV = this->indices.find(v);
+    if (iU == this->indices.end() || iV == this->indices.end())
+      return false;
+    return this->conjuntos.buscar(iU->second) ==
+           this->conjuntos.buscar(iV->second);
+  }
+
+  /**
+   * @brief Representante de la componente de v, o -1 si v no existe.
+   * Dos vértices tienen el mismo representante sii están conectados; el valor
+   * puede cambiar después de un addArco.
+   */
+  int componente(const V &v) {
+    typename map<V, int>::const_iterator it = this->indices.find(v);
+    if (it == this->indices.end())
+      return -1;
+    return this->conjuntos.buscar(it->second);
+  }
+
+  int nComponentes() const { return this->conjuntos.cantidadConjuntos(); }
+
+private:
+  Grafo<V> &grafo;
+  map<V, int> indices; // etiqueta -> índice en el union-find
+  UnionFind conjuntos;
+
+  int getIndice(const V &v) {
+    typename map<V, int>::const_iterator it = this->indices.find(v);
+    if (it != this->indices.end())
+      return it->second;
+    int i = this->conjuntos.agregar();
+    this->indices.insert({v, i});
+    return i;
+  }
+};
+
+#endif /* COMPONENTES_H_ */
@@ -0,0 +1,338 @@
+/****
+ * Flujo máximo / corte mínimo con push-relabel (preflujo).
+ *
+ * La red residual se guarda compacta en formato CSR: los arcos salientes de
+ * cada vértice quedan contiguos y cada arco conoce la posición de su reverso.
+ * Un arco u->v y su antiparalelo v->u comparten el mismo par de posiciones
+ * (cada uno es el reverso del otro), así una arista no dirigida ocupa dos
+ * lugares y no cuatro.
+ *
+ * Heurísticas:
+ * - Relabel global: cada tanto se recalculan todas las alturas como la
+ *   distancia al sumidero con un BFS en la red residual.
+ * - Gap: si ningún vértice queda con altura h, los que estaban por encima de
+ *   h ya no pueden llegar al sumidero y se suben a altura n de una vez. Los
+ *   vértices de altura < n están en una lista por altura, así subirlos sólo
+ *   recorre los que están por encima del hueco.
+ *
+ * Sólo se calcula el preflujo máximo (primera fase): alcanza para conocer el
+ * valor del flujo y el corte mínimo.
+ */
+#ifndef FLUJO_H_
+#define FLUJO_H_
+
+#include "rotulado/GrafoRotulado.hpp"
+#include <algorithm>
+#include <list>
+#include <map>
+#include <queue>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+template <class C> class RedResidual {
+public:
+  /**
+   * @brief Arma la red a partir de arcos (u, v, capacidad u->v, capacidad
+   * v->u). O(n + m)
+   */
+  RedResidual(int n, const vector<pair<pair<int, int>, pair<C, C>>> &arcos)
+      : n(n), inicio(n + 1, 0), destino(2 * arcos.size()),
+        residual(2 * arcos.size()), reverso(2 * arcos.size()) {
+    for (size_t i = 0; i < arcos.size(); i++) {
+      this->inicio[arcos[i].first.first + 1]++;
+      this->inicio[arcos[i].first.second + 1]++;
+    }
+    for (int v = 0; v < n; v++)
+      this->inicio[v + 1] += this->inicio[v];
+
+    vector<int> libre(this->inicio.begin(), this->inicio.end() - 1);
+    for (size_t i = 0; i < arcos.size(); i++) {
+      int u = arcos[i].first.first;
+      int v = arcos[i].first.second;
+      int a = libre[u]++;
+      int b = libre[v]++;
+      this->destino[a] = v;
+      this->residual[a] = arcos[i].second.first;
+      this->reverso[a] = b;
+      this->destino[b] = u;
+      this->residual[b] = arcos[i].second.second;
+      this->reverso[b] = a;
+    }
+  }
+
+  /**
+   * @brief Calcula el preflujo máximo de s a t. Con relabel FIFO la cota es
+   * O(n^3); en la práctica las heurísticas lo dejan cerca de lineal.
+   * @return Valor del flujo máximo.
+   */
+  C flujoMaximo(int s, int t) {
+    this->exceso.assign(this->n, C{});
+    this->altura.assign(this->n, 0);
+    this->primero.assign(this->n, -1);
+    this->siguienteAltura.assign(this->n, -1);
+    this->previoAltura.assign(this->n, -1);
+    this->actual.assign(this->inicio.begin(), this->inicio.end() - 1);
+    this->s = s;
+    this->t = t;
+    if (s == t)
+      return C{};
+
+    this->relabelGlobal();
+    for (int a = this->inicio[s]; a < this->inicio[s + 1]; a++)
+      if (this->residual[a] > C{}) {
+        this->exceso[s] += this->residual[a];
+        this->empujar(a, this->residual[a]);
+      }
+
+    int relabels = 0;
+    while (!this->activos.empty()) {
+      int v = this->activos.front();
+      this->activos.pop();
+      relabels += this->descargar(v);
+      if (relabels >= this->n) {
+        relabels = 0;
+        this->relabelGlobal();
+        for (int u = 0; u < this->n; u++)
+          if (u != s && u != t && this->exceso[u] > C{} &&
+              this->altura[u] < this->n)
+            this->activos.push(u);
+      }
+    }
+    return this->exceso[t];
+  }
+
+  /**
+   * @brief Lado de la fuente del corte mínimo: vértices desde los que no se
+   * llega al sumidero en la red residual. Llamar después de flujoMaximo.
+   * O(n + m)
+   */
+  vector<bool> ladoFuente() const {
+    vector<int> distancia = this->distanciasAlSumidero();
+    vector<bool> lado(this->n);
+    for (int v = 0; v < this->n; v++)
+      lado[v] = distancia[v] == -1;
+    return lado;
+  }
+
+private:
+  int n;
+  vector<int> inicio;  // arcos de v: [inicio[v], inicio[v+1])
+  vector<int> destino; // por arco
+  vector<C> residual;  // por arco
+  vector<int> reverso; // por arco
+
+  vector<C> exceso;
+  vector<int> altura;
+  // Listas doblemente enlazadas de los vértices de cada altura < n (para gap)
+  vector<int> primero;         // por altura: primer vértice, o -1
+  vector<int> siguienteAltura; // por vértice
+  vector<int> previoAltura;    // por vértice
+  int alturaMaxima;            // ninguna lista por encima de ésta tiene vértices
+  vector<int> actual;         // próximo arco a revisar de cada vértice
+  queue<int> activos;
+  int s, t;
+
+  /**
+   * @brief BFS desde t por arcos con residual positivo hacia t.
+   * @return Distancia de cada vértice a t, o -1 si no llega.
+   */
+  vector<int> distanciasAlSumidero() const {
+    vector<int> distancia(this->n, -1);
+    queue<int> q;
+    distancia[this->t] = 0;
+    q.push(this->t);
+    while (!q.empty()) {
+      int w = q.front();
+      q.pop();
+      for (int a = this->inicio[w]; a < this->inicio[w + 1]; a++) {
+        int v = this->destino[a];
+        if (distancia[v] == -1 && this->residual[this->reverso[a]] > C{}) {
+          distancia[v] = distancia[w] + 1;
+          q.push(v);
+        }
+      }
+    }
+    return distancia;
+  }
+
+  void relabelGlobal() {
+    vector<int> distancia = this->distanciasAlSumidero();
+    fill(this->primero.begin(), this->primero.end(), -1);
+    this->alturaMaxima = 0;
+    for (int v = 0; v < this->n; v++) {
+      this->altura[v] = distancia[v] == -1 ? this->n : distancia[v];
+      this->actual[v] = this->inicio[v];
+    }
+    this->altura[this->s] = this->n;
+    for (int v = 0; v < this->n; v++)
+      this->agregarAltura(v);
+  }
+
+  // Mete v en la lista de su altura (si es < n). O(1)
+  void agregarAltura(int v) {
+    int h = this->altura[v];
+    if (h >= this->n)
+      return;
+    this->siguienteAltura[v] = this->primero[h];
+    this->previoAltura[v] = -1;
+    if (this->primero[h] != -1)
+      this->previoAltura[this->primero[h]] = v;
+    this->primero[h] = v;
+    this->alturaMaxima = max(this->alturaMaxima, h);
+  }
+
+  // Saca v de la lista de su altura (si es < n). O(1)
+  void quitarAltura(int v) {
+    if (this->altura[v] >= this->n)
+      return;
+    int anterior = this->previoAltura[v];
+    int siguiente = this->siguienteAltura[v];
+    if (anterior != -1)
+      this->siguienteAltura[anterior] = siguiente;
+    else
+      this->primero[this->altura[v]] = siguiente;
+    if (siguiente != -1)
+      this->previoAltura[siguiente] = anterior;
+  }
+
+  void empujar(int a, C cantidad) {
+    int w = this->destino[a];
+    this->residual[a] -= cantidad;
+    this->residual[this->reverso[a]] += cantidad;
+    this->exceso[w] += cantidad;
+    this->exceso[this->destino[this->reverso[a]]] -= cantidad;
+    if (w != this->s && w != this->t && this->exceso[w] == cantidad &&
+        this->altura[w] < this->n)
+      this->activos.push(w); // recién se activó
+  }
+
+  /**
+   * @brief Empuja todo el exceso de v, reetiquetando cuando se queda sin
+   * arcos admisibles.
+   * @return Cantidad de relabels hechos.
+   */
+  int descargar(int v) {
+    int relabels = 0;
+    while (this->exceso[v] > C{} && this->altura[v] < this->n) {
+      if (this->actual[v] == this->inicio[v + 1]) {
+        this->relabel(v);
+        relabels++;
+        continue;
+      }
+      int a = this->actual[v];
+      int w = this->destino[a];
+      if (this->residual[a] > C{} && this->altura[v] == this->altura[w] + 1)
+        this->empujar(a, this->exceso[v] < this->residual[a]
+                             ? this->exceso[v]
+                             : this->residual[a]);
+      else
+        this->actual[v]++;
+    }
+    return relabels;
+  }
+
+  void relabel(int v) {
+    int anterior = this->altura[v];
+    int minima = 2 * this->n;
+    for (int a = this->inicio[v]; a < this->inicio[v + 1]; a++)
+      if (this->residual[a] > C{} && this->altura[this->destino[a]] < minima)
+        minima = this->altura[this->destino[a]];
+    this->quitarAltura(v);
+    this->altura[v] = min(minima + 1, this->n);
+    this->actual[v] = this->inicio[v];
+    if (anterior >= this->n || this->primero[anterior] != -1) {
+      this->agregarAltura(v);
+      return;
+    }
+
+    // Gap: nadie quedó en la altura anterior. v subió, así que también está
+    // por encima. Cada vértice que sube a n sale de las listas hasta el
+    // próximo relabel global, por eso el costo total queda acotado.
+    this->altura[v] = this->n;
+    for (int h = anterior + 1; h <= this->alturaMaxima; h++) {
+      for (int u = this->primero[h]; u != -1; u = this->siguienteAltura[u])
+        this->altura[u] = this->n;
+      this->primero[h] = -1;
+    }
+    this->alturaMaxima = anterior - 1;
+  }
+};
+
+template <class V, class C> struct ResultadoFlujo {
+  C valor;
+  set<V> corte;                // lado de la fuente del corte mínimo
+  list<pair<V, V>> arcosCorte; // arcos que cruzan el corte
+};
+
+/**
+ * @brief Flujo máximo de fuente a sumidero en un GrafoRotulado cuyos pesos son
+ * capacidades. En grafos no dirigidos cada arista vale en ambos sentidos.
+ * Si fuente o sumidero no existen el flujo es 0.
+ */
+template <class V, class C>
+ResultadoFlujo<V, C> flujoMaximo(const GrafoRotulado<V, C> &g, const V &fuente,
+                                 const V &sumidero) {
+  map<V, int> indice;
+  vector<V> etiqueta;
+  list<V> vertices = g.getVertices();
+  for (typename list<V>::const_iterator v = vertices.begin();
+       v != vertices.end(); v++) {
+    indice.insert({*v, etiqueta.size()});
+    etiqueta.push_back(*v);
+  }
+  // Destinos que no aparecen como vértices (sólo pasa en dirigidos)
+  for (typename list<V>::const_iterator v = vertices.begin();
+       v != vertices.end(); v++) {
+    list<V> ady = g.getAdyacentes(*v);
+    for (typename list<V>::const_iterator u = ady.begin(); u != ady.end(); u++)
+      if (indice.insert({*u, etiqueta.size()}).second)
+        etiqueta.push_back(*u);
+  }
+
+  // Un par antiparalelo u->v / v->u se guarda una sola vez
+  vector<pair<pair<int, int>, pair<C, C>>> arcos;
+  for (typename list<V>::const_iterator v = vertices.begin();
+       v != vertices.end(); v++) {
+    int i = indice[*v];
+    list<V> ady = g.getAdyacentes(*v);
+    for (typename list<V>::const_iterator u = ady.begin(); u != ady.end();
+         u++) {
+      int j = indice[*u];
+      if (i == j)
+        continue;
+      bool antiparalelo = g.hayArco(*u, *v);
+      if (i < j || !antiparalelo)
+        arcos.push_back({{i, j},
+                         {g.getPeso(*v, *u),
+                          antiparalelo ? g.getPeso(*u, *v) : C{}}});
+    }
+  }
+
+  ResultadoFlujo<V, C> resultado;
+  resultado.valor = C{};
+  if (indice.find(fuente) == indice.end() ||
+      indice.find(sumidero) == indice.end())
+    return resultado;
+
+  RedResidual<C> red(etiqueta.size(), arcos);
+  resultado.valor = red.flujoMaximo(indice[fuente], indice[sumidero]);
+
+  vector<bool> lado = red.ladoFuente();
+  for (size_t i = 0; i < etiqueta.size(); i++)
+    if (lado[i])
+      resultado.corte.insert(etiqueta[i]);
+  for (size_t k = 0; k < arcos.size(); k++) {
+    int u = arcos[k].first.first;
+    int v = arcos[k].first.second;
+    if (lado[u] && !lado[v] && arcos[k].second.first > C{})
+      resultado.arcosCorte.push_back({etiqueta[u], etiqueta[v]});
+    if (lado[v] && !lado[u] && arcos[k].second.second > C{})
+      resultado.arcosCorte.push_back({etiqueta[v], etiqueta[u]});
+  }
+  return resultado;
+}
+
+#endif /* FLUJO_H_ */
@@ -0,0 +1,46 @@
+/****
+ * Utilidades mínimas para repartir trabajo entre hilos.
+ */
+#ifndef HILOS_H_
+#define HILOS_H_
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Cantidad de hilos a usar: si nHilos <= 0 se usan todos los núcleos.
+ */
+inline int cantidadHilos(int nHilos) {
+  if (nHilos > 0)
+    return nHilos;
+  int n = thread::hardware_concurrency();
+  return n > 0 ? n : 1;
+}
+
+/**
+ * @brief Divide [0, n) en nHilos porciones contiguas y llama f(t, inicio, fin)
+ * para cada una en un hilo distinto. Espera a que terminen todos.
+ * Con un solo hilo no crea threads.
+ * @param f Invocable con firma void(int hilo, size_t inicio, size_t fin).
+ */
+template <class F> void paraCadaPorcion(size_t n, int nHilos, F f) {
+  nHilos = cantidadHilos(nHilos);
+  if (nHilos == 1 || n < 2) {
+    f(0, 0, n);
+    return;
+  }
+  const size_t porcion = (n + nHilos - 1) / nHilos;
+  vector<thread> hilos;
+  for (int t = 0; t < nHilos; t++) {
+    size_t inicio = min(n, t * porcion);
+    size_t fin = min(n, (t + 1) * porcion);
+    hilos.emplace_back(f, t, inicio, fin);
+  }
+  for (size_t t = 0; t < hilos.size(); t++)
+    hilos[t].join();
+}
+
+#endif /* HILOS_H_ */
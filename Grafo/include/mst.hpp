@@ -0,0 +1,251 @@
+/****
+ * Árbol recubridor mínimo (bosque, si el grafo no es conexo) sobre
+ * GrafoRotulado<V,C> no dirigidos.
+ *
+ * - kruskal: ordena las aristas en paralelo y las agrega con union-find.
+ * - prim: crece el árbol desde cada vértice no visitado usando un heap.
+ * - boruvka: en cada ronda cada componente elige su arista más liviana; la
+ *   búsqueda de esas aristas se reparte entre hilos.
+ *
+ * Las tres devuelven las aristas elegidas. Si el grafo es dirigido, los arcos
+ * se toman como aristas sin orientación.
+ */
+#ifndef MST_H_
+#define MST_H_
+
+#include "hilos.hpp"
+#include "rotulado/GrafoRotulado.hpp"
+#include "unionFind.hpp"
+#include <algorithm>
+#include <list>
+#include <map>
+#include <queue>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+template <class V, class C> struct Arista {
+  V origen;
+  V destino;
+  C peso;
+};
+
+// Arista con los extremos ya traducidos a índices 0..n-1.
+template <class C> struct AristaIndexada {
+  int u;
+  int v;
+  C peso;
+  bool operator<(const AristaIndexada &otra) const {
+    return this->peso < otra.peso;
+  }
+};
+
+/**
+ * @brief Numera los vértices y arma el arreglo de aristas. Cada arista no
+ * dirigida se guarda una sola vez. O(m log n)
+ * @param etiqueta Sale con la etiqueta de cada índice.
+ */
+template <class V, class C>
+vector<AristaIndexada<C>> indexarAristas(const GrafoRotulado<V, C> &g,
+                                         vector<V> &etiqueta) {
+  map<V, int> indice;
+  list<V> vertices = g.getVertices();
+  for (typename list<V>::const_iterator v = vertices.begin();
+       v != vertices.end(); v++) {
+    indice.insert({*v, etiqueta.size()});
+    etiqueta.push_back(*v);
+  }
+
+  vector<AristaIndexada<C>> aristas;
+  for (typename list<V>::const_iterator v = vertices.begin();
+       v != vertices.end(); v++) {
+    int i = indice[*v];
+    list<V> ady = g.getAdyacentes(*v);
+    for (typename list<V>::const_iterator u = ady.begin(); u != ady.end();
+         u++) {
+      // En dirigidos el destino puede no estar entre los vértices
+      if (indice.find(*u) == indice.end()) {
+        indice.insert({*u, etiqueta.size()});
+        etiqueta.push_back(*u);
+      }
+      int j = indice[*u];
+      if (i < j || (i > j && !g.hayArco(*u, *v)))
+        aristas.push_back({i, j, g.getPeso(*v, *u)});
+    }
+  }
+  return aristas;
+}
+
+template <class V, class C>
+Arista<V, C> desindexar(const AristaIndexada<C> &a, const vector<V> &etiqueta) {
+  return {etiqueta[a.u], etiqueta[a.v], a.peso};
+}
+
+/**
+ * @brief Ordena por peso: cada hilo ordena una porción con sort y después se
+ * mezclan las porciones de a pares con inplace_merge.
+ * O(m log m / nHilos + m log nHilos)
+ */
+template <class T> void ordenarParalelo(vector<T> &a, int nHilos) {
+  nHilos = cantidadHilos(nHilos);
+  const size_t porcion = (a.size() + nHilos - 1) / max(nHilos, 1);
+  if (nHilos == 1 || porcion == 0) {
+    sort(a.begin(), a.end());
+    return;
+  }
+  paraCadaPorcion(a.size(), nHilos, [&a](int, size_t inicio, size_t fin) {
+    sort(a.begin() + inicio, a.begin() + fin);
+  });
+  for (size_t ancho = porcion; ancho < a.size(); ancho *= 2) {
+    const size_t pares = (a.size() + 2 * ancho - 1) / (2 * ancho);
+    paraCadaPorcion(pares, nHilos, [&a, ancho](int, size_t inicio, size_t fin) {
+      for (size_t p = inicio; p < fin; p++) {
+        size_t medio = min(a.size(), (2 * p + 1) * ancho);
+        size_t finPar = min(a.size(), (2 * p + 2) * ancho);
+        inplace_merge(a.begin() + 2 * p * ancho, a.begin() + medio,
+                      a.begin() + finPar);
+      }
+    });
+  }
+}
+
+/**
+ * @brief Kruskal: aristas ordenadas en paralelo + UnionFind.
+ * O(m log m) (el orden se reparte entre nHilos) + O(m α(n)).
+ */
+template <class V, class C>
+list<Arista<V, C>> kruskal(const GrafoRotulado<V, C> &g, int nHilos = 0) {
+  vector<V> etiqueta;
+  vector<AristaIndexada<C>> aristas = indexarAristas(g, etiqueta);
+  ordenarParalelo(aristas, nHilos);
+
+  UnionFind conjuntos(etiqueta.size());
+  list<Arista<V, C>> arbol;
+  for (size_t i = 0; i < aristas.size() && arbol.size() + 1 < etiqueta.size();
+       i++)
+    if (conjuntos.unir(aristas[i].u, aristas[i].v))
+      arbol.push_back(desindexar(aristas[i], etiqueta));
+  return arbol;
+}
+
+/**
+ * @brief Prim con heap binario (priority_queue) y borrado perezoso.
+ * Arranca un árbol nuevo desde cada vértice no visitado, así que en grafos
+ * no conexos devuelve el bosque. O(m log m)
+ */
+template <class V, class C>
+list<Arista<V, C>> prim(const GrafoRotulado<V, C> &g) {
+  vector<V> etiqueta;
+  vector<AristaIndexada<C>> aristas = indexarAristas(g, etiqueta);
+  const int n = etiqueta.size();
+
+  vector<vector<int>> incidentes(n); // índices en aristas
+  for (size_t i = 0; i < aristas.size(); i++) {
+    incidentes[aristas[i].u].push_back(i);
+    incidentes[aristas[i].v].push_back(i);
+  }
+
+  typedef pair<C, int> Candidata; // (peso, índice de arista)
+  struct MayorPeso {
+    bool operator()(const Candidata &a, const Candidata &b) const {
+      return b.first < a.first;
+    }
+  };
+
+  vector<bool> enArbol(n, false);
+  list<Arista<V, C>> arbol;
+  for (int raiz = 0; raiz < n; raiz++) {
+    if (enArbol[raiz])
+      continue;
+    priority_queue<Candidata, vector<Candidata>, MayorPeso> heap;
+    enArbol[raiz] = true;
+    for (size_t k = 0; k < incidentes[raiz].size(); k++)
+      heap.push({aristas[incidentes[raiz][k]].peso, incidentes[raiz][k]});
+
+    while (!heap.empty()) {
+      const AristaIndexada<C> &a = aristas[heap.top().second];
+      heap.pop();
+      int nuevo = enArbol[a.u] ? a.v : a.u;
+      if (enArbol[nuevo])
+        continue; // ya quedó adentro por una arista más liviana
+      enArbol[nuevo] = true;
+      arbol.push_back(desindexar(a, etiqueta));
+      for (size_t k = 0; k < incidentes[nuevo].size(); k++) {
+        const AristaIndexada<C> &b = aristas[incidentes[nuevo][k]];
+        if (!enArbol[b.u] || !enArbol[b.v])
+          heap.push({b.peso, incidentes[nuevo][k]});
+      }
+    }
+  }
+  return arbol;
+}
+
+/**
+ * @brief Borůvka. En cada ronda cada hilo recorre una porción de las aristas
+ * y anota, para cada componente, la arista más liviana que sale de ella; las
+ * anotaciones de los hilos se combinan y se contraen las componentes. Hay a
+ * lo sumo log n rondas. O(m log n / nHilos + n log n)
+ * Empates: se desempata por índice de arista para no formar ciclos.
+ */
+template <class V, class C>
+list<Arista<V, C>> boruvka(const GrafoRotulado<V, C> &g, int nHilos = 0) {
+  vector<V> etiqueta;
+  vector<AristaIndexada<C>> aristas = indexarAristas(g, etiqueta);
+  const int n = etiqueta.size();
+  nHilos = cantidadHilos(nHilos);
+
+  // true si la arista a es más liviana que b (-1 = ninguna)
+  auto masLiviana = [&aristas](int a, int b) {
+    if (b == -1)
+      return true;
+    if (aristas[a].peso < aristas[b].peso)
+      return true;
+    if (aristas[b].peso < aristas[a].peso)
+      return false;
+    return a < b;
+  };
+
+  UnionFind conjuntos(n);
+  list<Arista<V, C>> arbol;
+  vector<int> componente(n);
+  vector<vector<int>> mejorPorHilo(nHilos, vector<int>(n, -1));
+  bool unio = true;
+
+  while (unio) {
+    unio = false;
+    for (int i = 0; i < n; i++)
+      componente[i] = conjuntos.buscar(i);
+
+    paraCadaPorcion(aristas.size(), nHilos,
+                    [&](int t, size_t inicio, size_t fin) {
+                      vector<int> &mejor = mejorPorHilo[t];
+                      for (size_t e = inicio; e < fin; e++) {
+                        int cu = componente[aristas[e].u];
+                        int cv = componente[aristas[e].v];
+                        if (cu == cv)
+                          continue;
+                        if (masLiviana(e, mejor[cu]))
+                          mejor[cu] = e;
+                        if (masLiviana(e, mejor[cv]))
+                          mejor[cv] = e;
+                      }
+                    });
+
+    for (int c = 0; c < n; c++) {
+      int e = -1;
+      for (int t = 0; t < nHilos; t++) {
+        if (mejorPorHilo[t][c] != -1 && masLiviana(mejorPorHilo[t][c], e))
+          e = mejorPorHilo[t][c];
+        mejorPorHilo[t][c] = -1; // queda limpio para la próxima ronda
+      }
+      if (e != -1 && conjuntos.unir(aristas[e].u, aristas[e].v)) {
+        arbol.push_back(desindexar(aristas[e], etiqueta));
+        unio = true;
+      }
+    }
+  }
+  return arbol;
+}
+
+#endif /* MST_H_ */
@@ -0,0 +1,183 @@
+/****
+ * PageRank sobre Grafo<V>.
+ *
+ * Un vértice es importante si lo apuntan vértices importantes: en cada
+ * iteración cada vértice reparte su puntaje en partes iguales entre sus
+ * adyacentes, y con probabilidad (1 - amortiguación) se salta a cualquier
+ * vértice. Los vértices sin salida reparten su puntaje entre todos.
+ *
+ * Se trabaja sobre una vista CSR de arcos entrantes: cada vértice "tira" de
+ * sus entrantes (pull), así cada hilo escribe sólo los puntajes de su porción
+ * de vértices y no hacen falta atómicos.
+ */
+#ifndef PAGERANK_H_
+#define PAGERANK_H_
+
+#include "hilos.hpp"
+#include "mapa/Grafo.hpp"
+#include <cmath>
+#include <map>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Vista compacta (CSR) de los arcos entrantes de un Grafo<V>, con los
+ * vértices numerados 0..n-1 en el orden de getVertices.
+ */
+template <class V> class GrafoCSR {
+public:
+  /**
+   * @brief Arma la vista. O((n + m) log n)
+   */
+  GrafoCSR(const Grafo<V> &g) {
+    set<V> vertices = g.getVertices();
+    for (typename set<V>::const_iterator v = vertices.begin();
+         v != vertices.end(); v++) {
+      this->indice.insert({*v, this->etiqueta.size()});
+      this->etiqueta.push_back(*v);
+    }
+    const int n = this->etiqueta.size();
+    this->gradoSalida.assign(n, 0);
+    this->inicioEntrantes.assign(n + 1, 0);
+
+    vector<pair<int, int>> arcos; // (origen, destino)
+    for (int u = 0; u < n; u++) {
+      set<V> ady = g.getAdyacentes(this->etiqueta[u]);
+      for (typename set<V>::const_iterator w = ady.begin(); w != ady.end();
+           w++) {
+        int v = this->indice[*w];
+        arcos.push_back({u, v});
+        this->gradoSalida[u]++;
+        this->inicioEntrantes[v + 1]++;
+      }
+    }
+    for (int v = 0; v < n; v++)
+      this->inicioEntrantes[v + 1] += this->inicioEntrantes[v];
+
+    this->entrantes.resize(arcos.size());
+    vector<int> libre(this->inicioEntrantes.begin(),
+                      this->inicioEntrantes.end() - 1);
+    for (size_t a = 0; a < arcos.size(); a++)
+      this->entrantes[libre[arcos[a].second]++] = arcos[a].first;
+  }
+
+  int nVertices() const { return this->etiqueta.size(); }
+
+  vector<V> etiqueta;          // índice -> vértice
+  map<V, int> indice;          // vértice -> índice
+  vector<int> gradoSalida;     // por vértice
+  vector<int> inicioEntrantes; // entrantes de v: [inicio[v], inicio[v+1])
+  vector<int> entrantes;       // origen de cada arco entrante
+};
+
+/**
+ * @brief PageRank sobre la vista CSR. O(k (n + m) / nHilos) con k iteraciones.
+ * @param puntaje Entra con el puntaje inicial (arranque en caliente; si no
+ * tiene n elementos se arranca con 1/n) y sale con el resultado, que suma 1.
+ * @param amortiguacion Probabilidad de seguir un arco (típicamente 0.85).
+ * @param tolerancia Se corta cuando la suma de |cambios| es menor.
+ * @param maxIteraciones Corte por cantidad de iteraciones.
+ * @param nHilos Hilos a usar (<= 0: todos los núcleos).
+ * @return Cantidad de iteraciones hechas.
+ */
+template <class V>
+int pageRank(const GrafoCSR<V> &g, vector<double> &puntaje,
+             double amortiguacion = 0.85, double tolerancia = 1e-9,
+             int maxIteraciones = 100, int nHilos = 0) {
+  const int n = g.nVertices();
+  if (n == 0)
+    return 0;
+  nHilos = cantidadHilos(nHilos);
+
+  if ((int)puntaje.size() != n)
+    puntaje.assign(n, 1.0 / n);
+  double total = 0;
+  for (int v = 0; v < n; v++)
+    total += puntaje[v];
+  for (int v = 0; v < n; v++)
+    puntaje[v] = total > 0 ? puntaje[v] / total : 1.0 / n;
+
+  vector<double> aporte(n); // puntaje[u] / gradoSalida[u]
+  vector<double> nuevo(n);
+  vector<double> sinSalidaPorHilo(nHilos);
+  vector<double> errorPorHilo(nHilos);
+
+  int iteracion = 0;
+  double error = tolerancia;
+  while (iteracion < maxIteraciones && error >= tolerancia) {
+    paraCadaPorcion(n, nHilos, [&](int t, size_t inicio, size_t fin) {
+      double sinSalida = 0;
+      for (size_t u = inicio; u < fin; u++) {
+        if (g.gradoSalida[u] == 0) {
+          sinSalida += puntaje[u];
+          aporte[u] = 0;
+        } else
+          aporte[u] = puntaje[u] / g.gradoSalida[u];
+      }
+      sinSalidaPorHilo[t] = sinSalida;
+    });
+    double sinSalida = 0;
+    for (int t = 0; t < nHilos; t++) {
+      sinSalida += sinSalidaPorHilo[t];
+      sinSalidaPorHilo[t] = 0;
+    }
+    const double base = (1 - amortiguacion) / n + amortiguacion * sinSalida / n;
+
+    paraCadaPorcion(n, nHilos, [&](int t, size_t inicio, size_t fin) {
+      double errorLocal = 0;
+      for (size_t v = inicio; v < fin; v++) {
+        double suma = 0;
+        for (int a = g.inicioEntrantes[v]; a < g.inicioEntrantes[v + 1]; a++)
+          suma += aporte[g.entrantes[a]];
+        nuevo[v] = base + amortiguacion * suma;
+        errorLocal += fabs(nuevo[v] - puntaje[v]);
+      }
+      errorPorHilo[t] = errorLocal;
+    });
+    error = 0;
+    for (int t = 0; t < nHilos; t++) {
+      error += errorPorHilo[t];
+      errorPorHilo[t] = 0;
+    }
+    puntaje.swap(nuevo);
+    iteracion++;
+  }
+  return iteracion;
+}
+
+/**
+ * @brief PageRank de un Grafo<V>.
+ * @param previo Puntajes de una corrida anterior para arrancar en caliente;
+ * los vértices nuevos arrancan con 1/n. Puede ser vacío.
+ * @return Mapa vértice -> puntaje (la suma da 1).
+ */
+template <class V>
+map<V, double> pageRank(const Grafo<V> &g, const map<V, double> &previo,
+                        double amortiguacion = 0.85, double tolerancia = 1e-9,
+                        int maxIteraciones = 100, int nHilos = 0) {
+  GrafoCSR<V> csr(g);
+  const int n = csr.nVertices();
+  vector<double> puntaje;
+  if (!previo.empty()) {
+    puntaje.assign(n, 1.0 / max(n, 1));
+    for (int v = 0; v < n; v++) {
+      typename map<V, double>::const_iterator it =
+          previo.find(csr.etiqueta[v]);
+      if (it != previo.end())
+        puntaje[v] = it->second;
+    }
+  }
+  pageRank(csr, puntaje, amortiguacion, tolerancia, maxIteraciones, nHilos);
+
+  map<V, double> resultado;
+  for (int v = 0; v < n; v++)
+    resultado.insert({csr.etiqueta[v], puntaje[v]});
+  return resultado;
+}
+
+template <class V> map<V, double> pageRank(const Grafo<V> &g) {
+  return pageRank(g, map<V, double>());
+}
+
+#endif /* PAGERANK_H_ */
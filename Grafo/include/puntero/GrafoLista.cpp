@@ -19,9 +19,19 @@
  * @section complexity Complejidades globales
  * - Estructura por listas enlazadas: operaciones típicas dependen del grado o
  * del número de vértices/aristas.
+ * - floydWarshall: O(n^3) repartido entre hilos, por bloques.
  * - Espacio: O(n + m).
+ *
+ * @section matriz Grafos con matriz
+ * Los métodos que también tiene la matriz de adyacencias se definen sólo
+ * acá: si el grafo se construyó con capacidad (grafoMatriz != nullptr)
+ * pasan a su versión *Matriz de GrafoMatriz.cpp.
  */
 #include "GrafoPuntero.hpp"
+#include "../caminosMinimos.hpp"
+#include <limits>
+#include <map>
+#include <type_traits>
 
 // =======================
 // Constructores / dtor
@@ -42,6 +52,10 @@ GrafoPuntero<TipoVertice, TipoArco>::GrafoPuntero() {
   this->nV = 0;
   this->nA = 0;
   this->noDirigido = false; // por defecto se asume dirigido
+  this->grafoMatriz = nullptr;
+  this->grafoMatrizVertices = nullptr;
+  this->grafoMatrizN = 0;
+  this->grafoMatrizNVertices = 0;
 }
 
 /**
@@ -59,6 +73,10 @@ GrafoPuntero<TipoVertice, TipoArco>::GrafoPuntero(bool noDir) {
   this->nV = 0;
   this->nA = 0;
   this->noDirigido = !(!noDir) ? true : false; // asegurar bool
+  this->grafoMatriz = nullptr;
+  this->grafoMatrizVertices = nullptr;
+  this->grafoMatrizN = 0;
+  this->grafoMatrizNVertices = 0;
 }
 
 /**
@@ -73,6 +91,8 @@ GrafoPuntero<TipoVertice, TipoArco>::GrafoPuntero(bool noDir) {
  */
 template <class TipoVertice, class TipoArco>
 GrafoPuntero<TipoVertice, TipoArco>::~GrafoPuntero() {
+  if (this->grafoMatriz)
+    this->liberarMatriz();
   Nodo *tempNodo = grafoNodo;
   while (tempNodo != nullptr) {
     Arco *tempArco = tempNodo->ady;
@@ -103,6 +123,8 @@ GrafoPuntero<TipoVertice, TipoArco>::~GrafoPuntero() {
  */
 template <class TipoVertice, class TipoArco>
 bool GrafoPuntero<TipoVertice, TipoArco>::addVertice(const TipoVertice &o) {
+  if (this->grafoMatriz)
+    return this->addVerticeMatriz(o);
   // Verificar duplicado
   Nodo *tmp = this->grafoNodo;
   while (tmp != nullptr) {
@@ -234,6 +256,8 @@ template <class TipoVertice, class TipoArco>
 bool GrafoPuntero<TipoVertice, TipoArco>::addArco(const TipoVertice &o,
                                                   const TipoVertice &d,
                                                   const TipoArco &peso) {
+  if (this->grafoMatriz)
+    return this->addArcoMatriz(o, d, peso);
   // Ubicar origen y destino
   Nodo *tempOrigen = this->grafoNodo;
   while (tempOrigen != nullptr && !(tempOrigen->etiqueta == o))
@@ -325,6 +349,8 @@ bool GrafoPuntero<TipoVertice, TipoArco>::addArco(const TipoVertice &o,
 template <class TipoVertice, class TipoArco>
 bool GrafoPuntero<TipoVertice, TipoArco>::delArco(const TipoVertice &o,
                                                   const TipoVertice &d) {
+  if (this->grafoMatriz)
+    return this->delArcoMatriz(o, d);
   // Buscar nodos
   Nodo *origen = this->grafoNodo;
   while (origen != nullptr && !(origen->etiqueta == o))
@@ -397,6 +423,8 @@ bool GrafoPuntero<TipoVertice, TipoArco>::delArco(const TipoVertice &o,
 template <class TipoVertice, class TipoArco>
 bool GrafoPuntero<TipoVertice, TipoArco>::hayArco(const TipoVertice &o,
                                                   const TipoVertice &d) const {
+  if (this->grafoMatriz)
+    return this->hayArcoMatriz(o, d);
   const Nodo *origen = this->grafoNodo;
   const Nodo *dest = this->grafoNodo;
 
@@ -436,6 +464,8 @@ template <class TipoVertice, class TipoArco>
 const TipoArco *
 GrafoPuntero<TipoVertice, TipoArco>::getPeso(const TipoVertice &o,
                                              const TipoVertice &d) const {
+  if (this->grafoMatriz)
+    return this->getPesoMatriz(o, d);
   const Nodo *origen = this->grafoNodo;
   const Nodo *dest = this->grafoNodo;
   while (origen != nullptr && !(origen->etiqueta == o))
@@ -522,6 +552,8 @@ void GrafoPuntero<TipoVertice, TipoArco>::setPeso(const TipoVertice &o,
  */
 template <class TipoVertice, class TipoArco>
 int GrafoPuntero<TipoVertice, TipoArco>::nVertices() const {
+  if (this->grafoMatriz)
+    return this->nVerticesMatriz();
   return this->nV;
 }
 
@@ -542,6 +574,8 @@ int GrafoPuntero<TipoVertice, TipoArco>::nVertices() const {
 template <class TipoVertice, class TipoArco>
 TipoVertice *GrafoPuntero<TipoVertice, TipoArco>::getAdyacentes(
     const TipoVertice &etiqueta) const {
+  if (this->grafoMatriz)
+    return this->getAdyacentesMatriz(etiqueta);
 
   Nodo *temp = this->grafoNodo;
   while (temp != nullptr && !(temp->etiqueta == etiqueta))
@@ -592,6 +626,10 @@ TipoVertice *GrafoPuntero<TipoVertice, TipoArco>::getVertices() const
  */
 template <class TipoVertice, class TipoArco>
 void GrafoPuntero<TipoVertice, TipoArco>::imprimir() const {
+  if (this->grafoMatriz) {
+    this->imprimirMatriz();
+    return;
+  }
   const Nodo *u = this->grafoNodo;
   while (u != nullptr) {
     cout << u->etiqueta << " :";
@@ -609,6 +647,62 @@ void GrafoPuntero<TipoVertice, TipoArco>::imprimir() const {
        << (this->noDirigido ? " (no dirigido)\n" : " (dirigido)\n");
 }
 
+// =======================
+// Caminos mínimos
+// =======================
+
+/**
+ * @brief Caminos mínimos entre todos los pares (Floyd-Warshall), con la
+ * misma versión por bloques que la implementación con matriz.
+ *
+ * Los vértices se numeran en el orden de la lista de nodos. La lista no
+ * tiene valor sentinela, así que "no hay camino" es numeric_limits::max()
+ * (o infinity() para punto flotante). La diagonal es TipoArco{} (o el costo
+ * de un lazo negativo). Con matriz se usa floydWarshallMatriz.
+ *
+ * @param nHilos Hilos a usar (<= 0: todos los núcleos).
+ * @return Arreglo contiguo new[] de nVertices x nVertices (fila i = origen
+ * i), que el llamador debe liberar con delete[]. Para costos no numéricos
+ * no está disponible y devuelve @c nullptr.
+ * @pre No hay ciclos de costo negativo y las distancias son menores a max().
+ * @complexity O(n^3 / nHilos + m log n) tiempo, O(n^2) espacio.
+ */
+template <class TipoVertice, class TipoArco>
+TipoArco *
+GrafoPuntero<TipoVertice, TipoArco>::floydWarshall(int nHilos) const {
+  if (this->grafoMatriz)
+    return this->floydWarshallMatriz(nHilos);
+  if constexpr (is_arithmetic<TipoArco>::value) {
+    typedef numeric_limits<TipoArco> Limites;
+    const TipoArco infinito =
+        Limites::has_infinity ? Limites::infinity() : Limites::max();
+
+    map<const Nodo *, int> indice;
+    for (const Nodo *u = this->grafoNodo; u != nullptr; u = u->sig)
+      indice.insert({u, (int)indice.size()});
+    const int n = indice.size();
+
+    TipoArco *dist = new TipoArco[(size_t)n * n];
+    fill(dist, dist + (size_t)n * n, infinito);
+    for (int i = 0; i < n; i++)
+      dist[(size_t)i * n + i] = TipoArco{};
+    for (const Nodo *u = this->grafoNodo; u != nullptr; u = u->sig) {
+      const size_t fila = (size_t)indice[u] * n;
+      for (const Arco *a = u->ady; a != nullptr; a = a->sig) {
+        TipoArco &d = dist[fila + indice[a->destino]];
+        if (a->valor < d)
+          d = a->valor;
+      }
+    }
+
+    floydWarshallBloques(dist, n, infinito, nHilos);
+    return dist;
+  } else {
+    (void)nHilos;
+    return nullptr;
+  }
+}
+
 // =======================
 // Instanciaciones explícitas
 // =======================
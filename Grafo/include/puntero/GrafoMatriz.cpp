@@ -1,9 +1,17 @@
 #include "GrafoPuntero.hpp"
+#include "../caminosMinimos.hpp"
+#include <limits>
+#include <type_traits>
 /**
  * @file GrafoMA.tpp
  * @brief Implementación de grafo con matriz de adyacencia y arreglo de
  * etiquetas.
  *
+ * Se usa cuando el grafo se construye con capacidad (GrafoPuntero(N, ...)).
+ * Los métodos comunes con la lista (addVertice, addArco, floydWarshall, ...)
+ * están en GrafoLista.cpp y llaman a los *Matriz de acá; el constructor por
+ * defecto es el de la lista.
+ *
  * Representación:
  *  - Matriz C** grafoMatriz de tamaño fijo N x N (capacidad).
  *  - Arreglo V* grafoMatrizVertices con hasta nVertices etiquetas.
@@ -17,6 +25,7 @@
  *  - addArco / delArco / hayArco / getCosto: O(1) una vez conocidas las claves.
  *  - getClave: O(N)).
  *  - getGrado / getAdyacentes: O(N) en el peor caso por recorrer fila.
+ *  - floydWarshall: O(n^3) repartido entre hilos, por bloques.
  *  - Espacio: O(N^2) + O(N).
  */
 
@@ -24,21 +33,6 @@
 // Constructores / Destructor
 // =======================
 
-/**
- * @brief Constructor por defecto.
- *
- * Crea grafo dirigido con capacidad N=1, sentinela -1 y 0 vértices cargados.
- * Llama a iniciarMatriz() e iniciarArreglo().
- */
-template <typename V, typename C> GrafoPuntero<V, C>::GrafoPuntero() {
-  this->grafoMatrizN = 1;
-  this->noDirigido = false;
-  this->grafoMatrizSinArista = -1;
-  this->grafoMatrizNVertices = 0;
-  this->iniciarMatriz();
-  this->iniciarArreglo();
-}
-
 /**
  * @brief Constructor con capacidad y modo dirigido/no dirigido.
  * @param capacidad_maxima Tamaño máximo N de la matriz (se trunca a 1 si es <=
@@ -54,6 +48,9 @@ GrafoPuntero<V, C>::GrafoPuntero(int capacidad_maxima, bool es_no_dirigido) {
   this->grafoMatrizNVertices = 0;
   if (this->grafoMatrizN <= 0)
     this->grafoMatrizN = 1;
+  this->grafoNodo = nullptr;
+  this->nV = 0;
+  this->nA = 0;
 
   this->iniciarMatriz();
   this->iniciarArreglo();
@@ -75,16 +72,19 @@ GrafoPuntero<V, C>::GrafoPuntero(int capacidad_maxima, bool es_no_dirigido,
   this->grafoMatrizNVertices = 0;
   if (this->grafoMatrizN <= 0)
     this->grafoMatrizN = 1;
+  this->grafoNodo = nullptr;
+  this->nV = 0;
+  this->nA = 0;
 
   this->iniciarMatriz();
   this->iniciarArreglo();
 }
 
 /**
- * @brief Destructor. Libera matriz y arreglo de vértices.
+ * @brief Libera matriz y arreglo de vértices (lo llama el destructor).
  * @post nVertices() pasa a 0.
  */
-template <typename V, typename C> GrafoPuntero<V, C>::~GrafoPuntero() {
+template <typename V, typename C> void GrafoPuntero<V, C>::liberarMatriz() {
   if (this->grafoMatriz) {
     for (int i = 0; i < this->grafoMatrizN; ++i)
       delete[] this->grafoMatriz[i];
@@ -103,7 +103,8 @@ template <typename V, typename C> GrafoPuntero<V, C>::~GrafoPuntero() {
  * @return nVertices (0..N).
  * @complexity O(1)
  */
-template <typename V, typename C> int GrafoPuntero<V, C>::nVertices() const {
+template <typename V, typename C>
+int GrafoPuntero<V, C>::nVerticesMatriz() const {
   return this->grafoMatrizNVertices;
 }
 
@@ -140,7 +141,7 @@ int GrafoPuntero<V, C>::getClave(const V &v) const {
  * @complexity O(1)
  */
 template <typename V, typename C>
-bool GrafoPuntero<V, C>::addVertice(const V &u) {
+bool GrafoPuntero<V, C>::addVerticeMatriz(const V &u) {
   if (this->grafoMatrizNVertices < this->grafoMatrizN) {
 
     this->grafoMatrizVertices[this->grafoMatrizNVertices] = u;
@@ -166,7 +167,8 @@ bool GrafoPuntero<V, C>::addVertice(const V &u) {
  * @note En no-dirigido también setea v->u con el mismo costo.
  */
 template <typename V, typename C>
-bool GrafoPuntero<V, C>::addArco(const V &u, const V &v, const C &c) {
+bool GrafoPuntero<V, C>::addArcoMatriz(const V &u, const V &v,
+                                       const C &c) {
   int iU = this->getClave(u);
   int iV = this->getClave(v);
   if (iU != -1 && iV != -1) {
@@ -188,7 +190,7 @@ bool GrafoPuntero<V, C>::addArco(const V &u, const V &v, const C &c) {
  * @complexity O(nVertices) por dos getClave + O(1) asignación.
  */
 template <typename V, typename C>
-bool GrafoPuntero<V, C>::delArco(const V &u, const V &v) {
+bool GrafoPuntero<V, C>::delArcoMatriz(const V &u, const V &v) {
   int iU = this->getClave(u);
   int iV = this->getClave(v);
   if (iU != -1 && iV != -1) {
@@ -209,7 +211,7 @@ bool GrafoPuntero<V, C>::delArco(const V &u, const V &v) {
  * @complexity O(nVertices) + O(1).
  */
 template <typename V, typename C>
-bool GrafoPuntero<V, C>::hayArco(const V &u, const V &v) const {
+bool GrafoPuntero<V, C>::hayArcoMatriz(const V &u, const V &v) const {
   int iU = this->getClave(u);
   int iV = this->getClave(v);
   if (iU == -1 || iV == -1)
@@ -229,7 +231,7 @@ bool GrafoPuntero<V, C>::hayArco(const V &u, const V &v) const {
  * se cambie la arista/sentinela.
  */
 template <typename V, typename C>
-const C *GrafoPuntero<V, C>::getPeso(const V &u, const V &v) const {
+const C *GrafoPuntero<V, C>::getPesoMatriz(const V &u, const V &v) const {
   int iU = getClave(u);
   int iV = getClave(v);
   if (iU == -1 || iV == -1)
@@ -246,7 +248,8 @@ const C *GrafoPuntero<V, C>::getPeso(const V &u, const V &v) const {
  * @complexity O(N^2).
  * @note Muestra N filas/columnas (capacidad), no solo los nVertices cargados.
  */
-template <typename V, typename C> void GrafoPuntero<V, C>::imprimir() const {
+template <typename V, typename C>
+void GrafoPuntero<V, C>::imprimirMatriz() const {
   cout << "   ";
   for (int j = 0; j < this->grafoMatrizN; j++)
     cout << "[" << this->grafoMatrizVertices[j]
@@ -273,17 +276,26 @@ int GrafoPuntero<V, C>::getGrado(const V &u) const
 /**
  * @brief Devuelve un arreglo con los adyacentes salientes de u.
  * @param u Etiqueta del vértice origen.
- * @return Arreglo dinámico de etiquetas V con tamaño getGrado(u); nullptr si u
- * no existe o no tiene vecinos.
+ * @return Arreglo dinámico de etiquetas V, uno por arista saliente; nullptr
+ * si u no existe o no tiene vecinos.
  * @complexity O(nVertices) + O(N). El llamador debe liberar con delete[].
  */
 template <typename V, typename C>
-V *GrafoPuntero<V, C>::getAdyacentes(const V &u) const
+V *GrafoPuntero<V, C>::getAdyacentesMatriz(const V &u) const
 
 {
   int key = this->getClave(u);
+  if (key == -1)
+    return nullptr;
+  // getGrado todavía no está implementado: se cuentan acá
+  int grado = 0;
+  for (int i = 0; i < this->grafoMatrizN; i++)
+    if (this->grafoMatriz[key][i] != this->grafoMatrizSinArista)
+      grado++;
+  if (grado == 0)
+    return nullptr;
   // vector<V> v;
-  V *v = new V[this->getGrado(u)];
+  V *v = new V[grado];
   int j = 0;
   for (int i = 0; i < this->grafoMatrizN; i++) {
     if (this->grafoMatriz[key][i] != this->grafoMatrizSinArista) {
@@ -295,6 +307,76 @@ V *GrafoPuntero<V, C>::getAdyacentes(const V &u) const
   return v;
 }
 
+// =======================
+// Caminos mínimos
+// =======================
+
+/**
+ * @brief Caminos mínimos entre todos los pares de vértices cargados
+ * (Floyd-Warshall).
+ *
+ * Para costos numéricos se usa la versión por bloques (floydWarshallBloques,
+ * en caminosMinimos.hpp). Para otros tipos de costo se usa el triple for
+ * clásico. En los dos casos la diagonal es C{} (o el costo de un lazo
+ * negativo).
+ *
+ * @param nHilos Hilos a usar (<= 0: todos los núcleos).
+ * @return Arreglo contiguo new[] de nVertices x nVertices (fila i = origen
+ * i); dist[i*n+j] es el costo mínimo de i a j. Si no hay camino es
+ * numeric_limits<C>::max() (infinity() en punto flotante), como en la
+ * lista, y no el sentinela, que puede ser un costo válido (-1 por defecto).
+ * Para costos no numéricos es el sentinela. El llamador debe liberarlo con
+ * delete[].
+ * @pre No hay ciclos de costo negativo y las distancias son menores a max().
+ * @complexity O(n^3 / nHilos) tiempo, O(n^2) espacio.
+ */
+template <typename V, typename C>
+C *GrafoPuntero<V, C>::floydWarshallMatriz(int nHilos) const {
+  const int n = this->grafoMatrizNVertices;
+  C *dist = new C[(size_t)n * n];
+
+  if constexpr (is_arithmetic<C>::value) {
+    const C infinito = numeric_limits<C>::has_infinity
+                           ? numeric_limits<C>::infinity()
+                           : numeric_limits<C>::max();
+    for (int i = 0; i < n; i++)
+      for (int j = 0; j < n; j++) {
+        const C c = this->grafoMatriz[i][j];
+        dist[(size_t)i * n + j] = c == this->grafoMatrizSinArista ? infinito : c;
+      }
+    for (int i = 0; i < n; i++)
+      if (C{} < dist[(size_t)i * n + i])
+        dist[(size_t)i * n + i] = C{};
+
+    floydWarshallBloques(dist, n, infinito, nHilos);
+  } else {
+    for (int i = 0; i < n; i++)
+      for (int j = 0; j < n; j++)
+        dist[(size_t)i * n + j] = this->grafoMatriz[i][j];
+    // Como en la rama numérica: ir de i a i cuesta C{} salvo un lazo negativo
+    for (int i = 0; i < n; i++) {
+      C &dii = dist[(size_t)i * n + i];
+      if (dii == this->grafoMatrizSinArista || C{} < dii)
+        dii = C{};
+    }
+    for (int k = 0; k < n; k++)
+      for (int i = 0; i < n; i++) {
+        const C dik = dist[(size_t)i * n + k];
+        if (i == k || dik == this->grafoMatrizSinArista)
+          continue;
+        for (int j = 0; j < n; j++) {
+          const C dkj = dist[(size_t)k * n + j];
+          if (j == k || dkj == this->grafoMatrizSinArista)
+            continue;
+          C &dij = dist[(size_t)i * n + j];
+          if (dij == this->grafoMatrizSinArista || dik + dkj < dij)
+            dij = dik + dkj;
+        }
+      }
+  }
+  return dist;
+}
+
 // =======================
 // Inicialización interna
 // =======================
@@ -30,7 +30,16 @@ public:
   int getGradoSalida(const V &v) const;
   int getGrado(const V &v) const;
 
-  // Métodos usados en la implementación con matriz de adyacencias y arreglos
+  // Caminos mínimos entre todos los pares, matriz nVertices^2 (new[]). Para
+  // costos numéricos "no hay camino" es numeric_limits<C>::max() (infinity()
+  // en punto flotante) en las dos implementaciones. Para los demás la
+  // matriz usa su sentinela y la lista devuelve nullptr.
+  C *floydWarshall(int nHilos = 0) const;
+
+  // Con estos constructores el grafo se guarda en una matriz de adyacencias
+  // y arreglos (GrafoMatriz.cpp); con los de arriba, en listas con punteros
+  // (GrafoLista.cpp). Los métodos comunes están definidos una sola vez, en
+  // GrafoLista.cpp, y pasan a su versión *Matriz si grafoMatriz != nullptr.
   GrafoPuntero(int capacidad_maxima, bool es_no_dirigido);
   GrafoPuntero(int capacidad_maxima, bool es_no_dirigido, C sin_arista_val);
 
@@ -70,6 +79,16 @@ private:
   void iniciarMatriz();
   void iniciarArreglo();
   int getClave(const V &v) const;
+  int nVerticesMatriz() const;
+  bool addVerticeMatriz(const V &u);
+  bool addArcoMatriz(const V &u, const V &v, const C &c);
+  bool delArcoMatriz(const V &u, const V &v);
+  bool hayArcoMatriz(const V &u, const V &v) const;
+  const C *getPesoMatriz(const V &u, const V &v) const;
+  void imprimirMatriz() const;
+  V *getAdyacentesMatriz(const V &u) const;
+  C *floydWarshallMatriz(int nHilos) const;
+  void liberarMatriz();
   /* *** */
 };
 
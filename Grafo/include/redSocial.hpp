@@ -16,9 +16,11 @@ Proponer un algoritmo. Detallar y justificar la complejidad algoritmica.
 #define REDSOCIAL_H_
 
 #include "mapa/Grafo.hpp"
+#include <algorithm>
 #include <map>
 #include <queue>
 #include <set>
+#include <vector>
 
 template <typename V> set<V> recomendaciones(Grafo<V> redSocial, V usuario) {
   set<V> visitado;
@@ -47,6 +49,28 @@ template <typename V> set<V> recomendaciones(Grafo<V> redSocial, V usuario) {
   }
   return recomendaciones;
 }
+/**
+ * Ordena las recomendaciones de mayor a menor puntaje (por ejemplo, el
+ * PageRank de pageRank.hpp). Las cuentas sin puntaje van al final.
+ * O(r log r + r log n)
+ */
+template <typename V>
+list<V> ordenarRecomendaciones(const set<V> &r, const map<V, double> &puntaje) {
+  vector<pair<double, V>> candidatos;
+  for (typename set<V>::const_iterator it = r.begin(); it != r.end(); it++) {
+    typename map<V, double>::const_iterator p = puntaje.find(*it);
+    candidatos.push_back({p == puntaje.end() ? -1.0 : p->second, *it});
+  }
+  stable_sort(candidatos.begin(), candidatos.end(),
+              [](const pair<double, V> &a, const pair<double, V> &b) {
+                return a.first > b.first;
+              });
+  list<V> ordenadas;
+  for (size_t i = 0; i < candidatos.size(); i++)
+    ordenadas.push_back(candidatos[i].second);
+  return ordenadas;
+}
+
 template <typename V> void mostrarRecomendaciones(set<V> r) {
   for (typename set<V>::const_iterator it = r.begin(); it != r.end(); it++)
     cout << *it << " ; ";
@@ -0,0 +1,148 @@
+/****
+ * Conjuntos disjuntos (union-find) sobre índices 0..n-1.
+ *
+ * - UnionFind: versión secuencial con unión por rango y compresión de
+ *   caminos. Puede crecer (agregar) a medida que aparecen vértices nuevos.
+ * - UnionFindConcurrente: versión sin locks para procesar arcos desde varios
+ *   hilos a la vez. Usa compare_exchange sobre el arreglo de padres.
+ */
+#ifndef UNIONFIND_H_
+#define UNIONFIND_H_
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+class UnionFind {
+public:
+  UnionFind() : nConjuntos(0) {}
+  UnionFind(int n) : nConjuntos(0) {
+    for (int i = 0; i < n; i++)
+      agregar();
+  }
+
+  /**
+   * @brief Agrega un conjunto unitario nuevo. O(1) amortizado.
+   * @return Índice del nuevo elemento.
+   */
+  int agregar() {
+    padre.push_back(padre.size());
+    rango.push_back(0);
+    nConjuntos++;
+    return padre.size() - 1;
+  }
+
+  /**
+   * @brief Representante del conjunto de x, comprimiendo el camino.
+   * O(α(n)) amortizado.
+   */
+  int buscar(int x) {
+    int raiz = x;
+    while (padre[raiz] != raiz)
+      raiz = padre[raiz];
+    while (padre[x] != raiz) {
+      int sig = padre[x];
+      padre[x] = raiz;
+      x = sig;
+    }
+    return raiz;
+  }
+
+  /**
+   * @brief Une los conjuntos de a y b (unión por rango).
+   * @return true si estaban separados.
+   */
+  bool unir(int a, int b) {
+    a = buscar(a);
+    b = buscar(b);
+    if (a == b)
+      return false;
+    if (rango[a] < rango[b])
+      swap(a, b);
+    padre[b] = a;
+    if (rango[a] == rango[b])
+      rango[a]++;
+    nConjuntos--;
+    return true;
+  }
+
+  int size() const { return padre.size(); }
+  int cantidadConjuntos() const { return nConjuntos; }
+
+private:
+  vector<int> padre;
+  vector<int> rango;
+  int nConjuntos;
+};
+
+class UnionFindConcurrente {
+public:
+  UnionFindConcurrente(int n) : padre(n) {
+    for (int i = 0; i < n; i++)
+      padre[i].store(i, memory_order_relaxed);
+  }
+
+  /**
+   * @brief Representante del conjunto de x. Comprime el camino por mitades
+   * (path halving) con CAS: si otro hilo cambió el padre en el medio, el CAS
+   * falla y simplemente seguimos subiendo.
+   */
+  int buscar(int x) {
+    while (true) {
+      int p = padre[x].load(memory_order_acquire);
+      if (p == x)
+        return x;
+      int abuelo = padre[p].load(memory_order_acquire);
+      if (p != abuelo)
+        padre[x].compare_exchange_weak(p, abuelo, memory_order_release,
+                                       memory_order_relaxed);
+      x = abuelo;
+    }
+  }
+
+  /**
+   * @brief Une los conjuntos de a y b. Siempre se cuelga la raíz de mayor
+   * índice debajo de la de menor índice, así los padres decrecen y no se
+   * pueden formar ciclos aunque dos hilos unan a la vez. Si el CAS falla es
+   * porque la raíz dejó de serlo: se reintenta desde los representantes.
+   * @return true si este llamado unió dos conjuntos distintos.
+   */
+  bool unir(int a, int b) {
+    while (true) {
+      a = buscar(a);
+      b = buscar(b);
+      if (a == b)
+        return false;
+      if (a < b)
+        swap(a, b);
+      int esperado = a;
+      if (padre[a].compare_exchange_strong(esperado, b, memory_order_acq_rel))
+        return true;
+    }
+  }
+
+  /**
+   * @brief Consulta si a y b están en el mismo conjunto. Es segura con
+   * uniones concurrentes: sólo responde false si la raíz de a sigue siendo
+   * raíz después de compararla.
+   */
+  bool mismoConjunto(int a, int b) {
+    while (true) {
+      a = buscar(a);
+      b = buscar(b);
+      if (a == b)
+        return true;
+      if (padre[a].load(memory_order_acquire) == a)
+        return false;
+    }
+  }
+
+  int size() const { return padre.size(); }
+
+private:
+  vector<atomic<int>> padre;
+};
+
+#endif /* UNIONFIND_H_ */
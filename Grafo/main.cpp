@@ -2,7 +2,11 @@
 #include "include/puntero/GrafoLista.cpp"
 #include "include/rotulado/GrafoRotulado.hpp"
 
+#include "include/componentes.hpp"
 #include "include/dfs.hpp"
+#include "include/flujo.hpp"
+#include "include/mst.hpp"
+#include "include/pageRank.hpp"
 #include "include/redSocial.hpp"
 
 /**
@@ -131,12 +135,144 @@ int redSocial() {
   cout << "\nRecomendaciones para " << usuario << endl;
   mostrarRecomendaciones(r);
 
+  map<string, double> puntaje = pageRank(g);
+  list<string> ordenadas = ordenarRecomendaciones(r, puntaje);
+  cout << "\nOrdenadas por PageRank\n";
+  for (list<string>::const_iterator it = ordenadas.begin();
+       it != ordenadas.end(); it++)
+    cout << *it << " (" << puntaje[*it] << ") ; ";
+  cout << "\n";
+
+  return 0;
+}
+
+/**
+Prueba de componentes conexas (en paralelo e incrementales)
+***/
+int componentes() {
+  Grafo<char> g(true);
+
+  g.addArco('A', 'B');
+  g.addArco('B', 'C');
+  g.addArco('D', 'E');
+  g.addVertice('F');
+
+  cout << "\n\nComponentes conexas\n";
+  map<char, int> c = componentesConexas(g);
+  for (map<char, int>::const_iterator it = c.begin(); it != c.end(); it++)
+    cout << it->first << ": " << it->second << "\n";
+
+  ComponentesIncrementales<char> inc(g);
+  cout << "Componentes: " << inc.nComponentes() << "\n";
+  cout << "A-E conectados? " << inc.conectados('A', 'E') << "\n";
+  inc.addArco('C', 'D');
+  cout << "Componentes: " << inc.nComponentes() << "\n";
+  cout << "A-E conectados? " << inc.conectados('A', 'E') << "\n";
+
+  return 0;
+}
+
+/**
+Prueba de árbol recubridor mínimo (Kruskal, Prim y Borůvka)
+***/
+int arbolRecubridor() {
+  GrafoRotulado<char, int> g(true);
+
+  g.addArco('A', 'B', 4);
+  g.addArco('A', 'C', 1);
+  g.addArco('B', 'C', 2);
+  g.addArco('B', 'D', 5);
+  g.addArco('C', 'D', 8);
+  g.addArco('D', 'E', 3);
+
+  list<Arista<char, int>> arboles[3] = {kruskal(g), prim(g), boruvka(g)};
+  string nombres[3] = {"Kruskal", "Prim", "Boruvka"};
+
+  cout << "\n\nArbol recubridor minimo\n";
+  for (int i = 0; i < 3; i++) {
+    int total = 0;
+    cout << nombres[i] << ": ";
+    for (list<Arista<char, int>>::const_iterator a = arboles[i].begin();
+         a != arboles[i].end(); a++) {
+      cout << a->origen << "-" << a->destino << "(" << a->peso << ") ";
+      total += a->peso;
+    }
+    cout << " Total = " << total << "\n";
+  }
+
+  return 0;
+}
+
+/**
+Prueba de flujo máximo / corte mínimo
+***/
+int flujo() {
+  GrafoRotulado<char, int> g;
+
+  g.addArco('S', 'A', 10);
+  g.addArco('S', 'B', 5);
+  g.addArco('A', 'B', 15);
+  g.addArco('A', 'T', 5);
+  g.addArco('B', 'T', 10);
+
+  ResultadoFlujo<char, int> r = flujoMaximo(g, 'S', 'T');
+
+  cout << "\n\nFlujo maximo S->T = " << r.valor << "\nCorte: { ";
+  for (set<char>::const_iterator v = r.corte.begin(); v != r.corte.end(); v++)
+    cout << *v << " ";
+  cout << "}\nArcos del corte: ";
+  for (list<pair<char, char>>::const_iterator a = r.arcosCorte.begin();
+       a != r.arcosCorte.end(); a++)
+    cout << a->first << "->" << a->second << " ";
+  cout << "\n";
+
+  return 0;
+}
+
+/**
+Prueba de caminos mínimos entre todos los pares (Floyd-Warshall)
+***/
+int caminosMinimos() {
+  const char vertices[] = {'A', 'B', 'C', 'D'};
+  const int n = 4;
+  // Con matriz de adyacencias: capacidad n, dirigido, -1 como "no hay arco"
+  GrafoPuntero<char, int> g(n, false, -1);
+  for (int i = 0; i < n; i++)
+    g.addVertice(vertices[i]);
+
+  g.addArco('A', 'B', 4);
+  g.addArco('A', 'C', 1);
+  g.addArco('C', 'B', 2);
+  g.addArco('B', 'D', 5);
+  g.addArco('D', 'C', -3); // D-B cuesta -1, igual al sentinela
+
+  int *dist = g.floydWarshall();
+
+  cout << "\n\nCaminos minimos (Floyd-Warshall)\n";
+  for (int i = 0; i < n; i++) {
+    cout << vertices[i] << ":";
+    for (int j = 0; j < n; j++) {
+      const int d = dist[i * n + j];
+      if (d == numeric_limits<int>::max())
+        cout << " -";
+      else
+        cout << " " << d;
+    }
+    cout << "\n";
+  }
+  delete[] dist;
+
   return 0;
 }
 
 int main() {
   grafoRotulado();
   grafo();
+  componentes();
+  arbolRecubridor();
+  flujo();
+  redSocial();
+  caminosMinimos();
   grafoPuntero();
 
   return 0;
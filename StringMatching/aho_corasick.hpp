@@ -0,0 +1,206 @@
+#ifndef AHO_CORASICK_HPP
+#define AHO_CORASICK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "flujo.hpp"
+
+// Aho-Corasick: el autómata finito de automata_finito.hpp generalizado a
+// muchos patrones. Los estados son los nodos del trie de los patrones y las
+// transiciones que faltan se completan con los enlaces de falla, así que
+// cada byte del texto es exactamente un paso, sin retrocesos.
+//
+// La tabla es densa (una fila por estado), pero las columnas no son los 256
+// bytes sino clases: una por cada byte que aparece en algún patrón y una
+// más para todos los demás, que desde cualquier estado vuelven a la raíz.
+// Con textos y palabras clave en un alfabeto chico las filas quedan cortas
+// y la tabla entra mucho mejor en caché.
+//
+// Cada entrada de la tabla guarda el comienzo de una fila en 31 bits (el
+// bit alto marca salidas), así que estados * clases no puede pasar de 2^31.
+// Si los patrones no entran el autómata no se arma: valido() da false y
+// feed no hace nada.
+//
+// Para armarla se cuentan primero los estados, así la tabla se pide una sola
+// vez y del tamaño justo; el trie se arma y se completa dentro de ella. El
+// pico de memoria es la tabla (4 * estados * clases bytes) más unos 16
+// bytes por estado y 8 por patrón.
+class aho_corasick_stream {
+public:
+  // Los patrones vacíos se ignoran. Los repetidos se informan todos.
+  aho_corasick_stream(const std::vector<std::string> &patrones,
+                      callback_multi cb)
+      : cb(cb), armado(false) {
+    for (int c = 0; c < 256; c++)
+      this->clase[c] = 0;
+    this->clases = 1;
+    for (size_t k = 0; k < patrones.size(); k++)
+      for (size_t i = 0; i < patrones[k].size(); i++) {
+        unsigned char c = patrones[k][i];
+        if (this->clase[c] == 0)
+          this->clase[c] = this->clases++;
+      }
+
+    // Estados del trie: con los patrones ordenados, cada uno agrega los
+    // bytes que no comparte con el anterior
+    const size_t C = this->clases;
+    size_t estados = 1;
+    {
+      std::vector<size_t> orden(patrones.size());
+      std::iota(orden.begin(), orden.end(), 0);
+      std::sort(orden.begin(), orden.end(), [&](size_t a, size_t b) {
+        return patrones[a] < patrones[b];
+      });
+      for (size_t i = 0; i < orden.size(); i++) {
+        const std::string &P = patrones[orden[i]];
+        size_t comun = 0;
+        if (i > 0) {
+          const std::string &Q = patrones[orden[i - 1]];
+          while (comun < Q.size() && comun < P.size() && Q[comun] == P[comun])
+            comun++;
+        }
+        estados += P.size() - comun;
+      }
+    }
+    if (estados * C > SALIDA) {
+      this->descartar();
+      return;
+    }
+
+    // Trie dentro de la tabla: hijo[s * clases + c], NADA si no hay
+    std::vector<uint32_t> &hijo = this->D;
+    hijo.assign(estados * C, NADA);
+    this->propio.assign(estados, -1);
+    this->largo.resize(patrones.size());
+    this->igual.assign(patrones.size(), -1);
+    uint32_t nuevos = 1;
+    for (size_t k = 0; k < patrones.size(); k++) {
+      const std::string &P = patrones[k];
+      this->largo[k] = P.size();
+      if (P.empty())
+        continue;
+      uint32_t s = 0;
+      for (size_t i = 0; i < P.size(); i++) {
+        uint32_t &h = hijo[s * C + this->clase[(unsigned char)P[i]]];
+        if (h == NADA)
+          h = nuevos++;
+        s = h;
+      }
+      this->igual[k] = this->propio[s];
+      this->propio[s] = k;
+    }
+
+    // Por niveles: la falla de un estado es más corta, así que ya tiene su
+    // fila completa y su salida cuando se la necesita.
+    this->falla.assign(estados, 0);
+    this->salida.assign(estados, -1);
+    std::vector<int32_t> cola;
+    cola.reserve(estados);
+    for (size_t c = 0; c < C; c++) {
+      uint32_t &v = hijo[c];
+      if (v == NADA)
+        v = 0;
+      else
+        cola.push_back(v);
+    }
+    for (size_t i = 0; i < cola.size(); i++) {
+      const int32_t u = cola[i];
+      const int32_t f = this->falla[u];
+      this->salida[u] = this->propio[u] >= 0 ? u : this->salida[f];
+      for (size_t c = 0; c < C; c++) {
+        uint32_t &v = hijo[u * C + c];
+        if (v == NADA)
+          v = hijo[f * C + c];
+        else {
+          this->falla[v] = hijo[f * C + c];
+          cola.push_back(v);
+        }
+      }
+    }
+
+    // Como en automata_stream cada entrada pasa a ser el comienzo de la fila
+    // siguiente; el bit alto avisa que ese estado tiene alguna salida. Cada
+    // entrada se lee una sola vez, así que se reemplaza en el lugar.
+    for (size_t i = 0; i < hijo.size(); i++)
+      hijo[i] = hijo[i] * C | (this->salida[hijo[i]] >= 0 ? SALIDA : 0);
+    this->armado = true;
+    this->reset();
+  }
+
+  // false si los patrones no entraban en la tabla (ver arriba)
+  bool valido() const { return this->armado; }
+
+  void reset() {
+    this->q = 0;
+    this->leidos = 0;
+  }
+
+  size_t offset() const { return this->leidos; }
+
+  size_t size() const { return this->propio.size(); }
+
+  void feed(const char *chunk, size_t len) {
+    if (!this->armado)
+      return;
+    const unsigned char *T = (const unsigned char *)chunk;
+    const uint32_t *D = this->D.data();
+    uint32_t q = this->q;
+    for (size_t i = 0; i < len; i++) {
+      q = D[q + this->clase[T[i]]];
+      if (q & SALIDA) {
+        q &= ~SALIDA;
+        this->informar(q / this->clases, this->leidos + i + 1);
+      }
+    }
+    this->q = q;
+    this->leidos += len;
+  }
+
+private:
+  static constexpr uint32_t SALIDA = uint32_t(1) << 31;
+  static constexpr uint32_t NADA = ~uint32_t(0); // en el trie: no hay hijo
+
+  callback_multi cb;
+  uint32_t clase[256];
+  uint32_t clases;
+  std::vector<uint32_t> D;      // estados x clases
+  std::vector<int32_t> falla;
+  std::vector<int32_t> propio;  // un patrón que termina en el estado, o -1
+  std::vector<int32_t> igual;   // el siguiente patrón igual a éste, o -1
+  std::vector<int32_t> salida;  // el estado más largo en la cadena de fallas
+                                // que tiene patrones propios, o -1
+  std::vector<size_t> largo;
+  bool armado;
+  uint32_t q;                   // estado actual * clases
+  size_t leidos;
+
+  void descartar() {
+    this->D.clear();
+    this->propio.clear();
+    this->igual.clear();
+    this->largo.clear();
+    this->reset();
+  }
+
+  // Todos los patrones que terminan en la posición fin - 1 del flujo
+  void informar(int32_t s, size_t fin) {
+    for (int32_t t = this->salida[s]; t >= 0; t = this->salida[this->falla[t]])
+      for (int32_t k = this->propio[t]; k >= 0; k = this->igual[k])
+        this->cb(fin - this->largo[k], k);
+  }
+};
+
+// Busca todos los patrones en T (de largo n) en una pasada
+inline void aho_corasick_matcher(const char *T, size_t n,
+                                 const std::vector<std::string> &patrones,
+                                 const callback_multi &cb) {
+  aho_corasick_stream buscador(patrones, cb);
+  buscador.feed(T, n);
+}
+
+#endif // AHO_CORASICK_HPP
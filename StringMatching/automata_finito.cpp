@@ -1,53 +1,84 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
-#include <cmath>
-#include <bits/stdc++.h>
+#include <string>
+#include <vector>
+
+#include "aho_corasick.hpp"
+#include "automata_finito.hpp"
+#include "busqueda_paralela.hpp"
 
 using namespace std;
 
-bool es_sufijo(char P[],int k,int q,char s)
+// Sin argumentos muestra el autómata de "abcab" sobre {a, b, c} y lo corre
+// sobre un texto de ejemplo. Con argumentos:
+//   automata_finito [-j HILOS] PATRON [ARCHIVO]
+//   automata_finito -f PATRONES [ARCHIVO]   (un patrón por línea, con
+//                                           Aho-Corasick)
+// busca en ARCHIVO, o en la entrada estándar si no se da. Con -j el
+// archivo se mapea y se reparte entre HILOS hilos (0: todos los núcleos);
+// si no se puede mapear se lee de a pedazos en un hilo.
+int main(int argc, char *argv[])
 {
-  string ending="" ;
-  for (int i=0;i<k;i++)
-      ending = ending+P[i];
-  string fullString="";
-  for (int i = 0;i<q;i++)
-      fullString = fullString + P[i];
-  fullString = fullString + s;
-  if (fullString.length() >= ending.length()) {
-        return (0 == fullString.compare (fullString.length() - ending.length(), ending.length(), ending));
-    } else {
-        return false;
-    }
-}
+    callback_match mostrar = [](size_t i) {
+        cout << "Matching con desplazamiento: " << i << endl;
+    };
 
-// P el patrón; S arreglo con las cadenas del lenguaje
-void compute_transition_function(char P[],char S[],int D[5][3])
-{
-  
-  int m = strlen(P);
-  int n = strlen(S);
+    if (argc < 2) {
+        char P[6] = "abcab";
+        char S[4] = "abc";
+        automata_finito A;
+        if (!compute_transition_function(P, strlen(P), S, strlen(S), A))
+            return 1;
+        for (size_t q = 0; q <= A.m; q++) {
+            for (size_t s = 0; s < A.sigma; s++)
+                cout << A.siguiente(q, s) << " ";
+            cout << endl;
+        }
+        const char T[] = "abcabcabab";
+        automata_matcher(T, strlen(T), P, strlen(P), mostrar);
+        return 0;
+    }
 
-  for (int q=0;q<m;q++){
-      for (int s=0;s<n;s++){
-          int k;
-          if (m+1<q+2)
-              k=m+1;
-          else
-              k=q+2;
-          do {
-              k=k-1;
-          }while (!es_sufijo(P,k,q,S[s]));
-          D[q][s]=k;
-      }
-  }
-}
+    int hilos = -1; // sin -j
+    int i = 1;
+    if (strcmp(argv[1], "-j") == 0 && argc > 3) {
+        hilos = atoi(argv[2]);
+        i = 3;
+    }
 
-int main()
-{
-    char P[6] = "abcab";
-    char S[4] = "abc";
-    int D[5][3];
-    compute_transition_function(P,S,D);
+    bool ok;
+    const char *archivo;
+    if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+        ifstream lista(argv[i + 1]);
+        vector<string> patrones;
+        string linea;
+        while (getline(lista, linea))
+            patrones.push_back(linea);
+        aho_corasick_stream buscador(patrones, [&](size_t i, size_t k) {
+            cout << "Matching de \"" << patrones[k] << "\" con desplazamiento: "
+                 << i << endl;
+        });
+        if (!buscador.valido()) {
+            cerr << "Demasiados patrones para la tabla del automata" << endl;
+            return 1;
+        }
+        archivo = i + 2 < argc ? argv[i + 2] : nullptr;
+        ok = archivo ? stream_file(archivo, buscador) : stream_fd(0, buscador);
+    } else {
+        const char *P = argv[i];
+        archivo = i + 1 < argc ? argv[i + 1] : nullptr;
+        ok = archivo && hilos >= 0 &&
+             parallel_file(archivo, P, strlen(P), mostrar, automata_matcher,
+                           hilos);
+        if (!ok)
+            ok = archivo ? automata_file(archivo, P, strlen(P), mostrar)
+                         : automata_fd(0, P, strlen(P), mostrar);
+    }
+    if (!ok) {
+        cerr << "No se pudo leer " << (archivo ? archivo : "la entrada") << endl;
+        return 1;
+    }
     return 0;
 }
-
@@ -0,0 +1,141 @@
+#ifndef AUTOMATA_FINITO_HPP
+#define AUTOMATA_FINITO_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "flujo.hpp"
+
+// Autómata de coincidencia de un patrón P de largo m sobre el alfabeto S de
+// sigma símbolos: estados 0..m (el estado q dice que los últimos q símbolos
+// leídos son P[0..q-1]) y transiciones en una tabla plana de (m+1) x sigma.
+struct automata_finito {
+  size_t m;
+  size_t sigma;
+  std::vector<int> D; // D[q * sigma + s]: estado después de leer S[s] en q
+
+  int siguiente(int q, size_t s) const { return this->D[q * this->sigma + s]; }
+};
+
+// pi[q] = largo del mayor prefijo propio de P[0..q] que también es sufijo
+inline std::vector<int> compute_prefix_function(const char *P, size_t m) {
+  std::vector<int> pi(m, 0);
+  int k = 0;
+  for (size_t q = 1; q < m; q++) {
+    while (k > 0 && P[k] != P[q])
+      k = pi[k - 1];
+    if (P[k] == P[q])
+      k++;
+    pi[q] = k;
+  }
+  return pi;
+}
+
+// Arma el autómata en O(m * sigma). Desde el estado q > 0, un símbolo que no
+// extiende la coincidencia lleva a donde lo llevaría el estado pi[q-1] (el
+// mayor borde de P[0..q-1]), cuya fila ya está calculada: basta copiarla y
+// corregir la transición por P[q]. Devuelve false si P usa un símbolo que no
+// está en S.
+inline bool compute_transition_function(const char *P, size_t m, const char *S,
+                                        size_t sigma, automata_finito &A) {
+  if (sigma == 0)
+    return false;
+  int indice[256]; // símbolo -> posición en S
+  for (int c = 0; c < 256; c++)
+    indice[c] = -1;
+  for (size_t s = 0; s < sigma; s++)
+    indice[(unsigned char)S[s]] = s;
+  for (size_t i = 0; i < m; i++)
+    if (indice[(unsigned char)P[i]] < 0)
+      return false;
+
+  std::vector<int> pi = compute_prefix_function(P, m);
+  A.m = m;
+  A.sigma = sigma;
+  A.D.assign((m + 1) * sigma, 0);
+  for (size_t q = 0; q <= m; q++) {
+    int *fila = &A.D[q * sigma];
+    if (q > 0) {
+      const int *borde = &A.D[pi[q - 1] * sigma];
+      for (size_t s = 0; s < sigma; s++)
+        fila[s] = borde[s];
+    }
+    if (q < m)
+      fila[indice[(unsigned char)P[q]]] = q + 1;
+  }
+  return true;
+}
+
+// Corre el autómata de P sobre un flujo que llega de a pedazos; el estado
+// pasa de un pedazo al siguiente. Las filas son de 256 (una columna por
+// byte, sin traducir al alfabeto) y cada entrada guarda estado * 256, o sea
+// el comienzo de la fila siguiente: el paso es una sola lectura de la tabla.
+// Ocupa (m+1) KB de tabla.
+class automata_stream {
+public:
+  automata_stream(const char *P, size_t m, callback_match cb) : m(m), cb(cb) {
+    char bytes[256];
+    for (int c = 0; c < 256; c++)
+      bytes[c] = c;
+    automata_finito A;
+    compute_transition_function(P, m, bytes, 256, A);
+    this->D.resize(A.D.size());
+    for (size_t i = 0; i < A.D.size(); i++)
+      this->D[i] = A.D[i] * 256;
+    this->reset();
+  }
+
+  void reset() {
+    this->q = 0;
+    this->leidos = 0;
+  }
+
+  size_t offset() const { return this->leidos; }
+
+  void feed(const char *chunk, size_t len) {
+    if (this->m == 0)
+      return;
+    const unsigned char *T = (const unsigned char *)chunk;
+    const uint32_t *D = this->D.data();
+    const uint32_t final = this->m * 256;
+    // Posición en el flujo de la ocurrencia que termina en T[i]
+    const size_t base = this->leidos + 1 - this->m;
+    uint32_t q = this->q;
+    for (size_t i = 0; i < len; i++) {
+      q = D[q + T[i]];
+      if (q == final)
+        this->cb(base + i);
+    }
+    this->q = q;
+    this->leidos += len;
+  }
+
+private:
+  size_t m;
+  callback_match cb;
+  std::vector<uint32_t> D; // (m+1) x 256, entradas multiplicadas por 256
+  uint32_t q;              // estado actual * 256
+  size_t leidos;
+};
+
+// Busca P (de largo m) en T (de largo n)
+inline void automata_matcher(const char *T, size_t n, const char *P, size_t m,
+                             const callback_match &cb) {
+  automata_stream buscador(P, m, cb);
+  buscador.feed(T, n);
+}
+
+inline bool automata_fd(int fd, const char *P, size_t m,
+                        const callback_match &cb) {
+  automata_stream buscador(P, m, cb);
+  return stream_fd(fd, buscador);
+}
+
+inline bool automata_file(const char *ruta, const char *P, size_t m,
+                          const callback_match &cb) {
+  automata_stream buscador(P, m, cb);
+  return stream_file(ruta, buscador);
+}
+
+#endif // AUTOMATA_FINITO_HPP
@@ -0,0 +1,130 @@
+#ifndef BOYER_MOORE_HPP
+#define BOYER_MOORE_HPP
+
+#include <cstddef>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "flujo.hpp"
+
+// Algoritmos que comparan la ventana de derecha a izquierda y, ante una
+// diferencia, saltan varias posiciones sin mirar los bytes del medio. Con
+// patrones largos sobre texto natural leen una fracción chica del texto.
+// Se construyen una vez por patrón y después buscan en cuantos textos haga
+// falta.
+
+// Boyer-Moore con las dos reglas: mal carácter y buen sufijo. El salto es
+// el mayor de los dos, así que el peor caso por ventana queda acotado
+// también con patrones repetitivos.
+class boyer_moore {
+public:
+  boyer_moore(const char *P, size_t m) : patron(P, m) {
+    // Mal carácter: cuánto correr para alinear la última aparición de c
+    for (int c = 0; c < 256; c++)
+      this->malo[c] = m;
+    for (size_t i = 0; i + 1 < m; i++)
+      this->malo[(unsigned char)P[i]] = m - 1 - i;
+
+    // sufijo[i] = largo del mayor sufijo de P que termina en P[i]
+    const long M = m;
+    std::vector<long> sufijo(m);
+    if (m > 0)
+      sufijo[m - 1] = m;
+    long g = M - 1, f = M - 1;
+    for (long i = M - 2; i >= 0; i--) {
+      if (i > g && sufijo[i + M - 1 - f] < i - g)
+        sufijo[i] = sufijo[i + M - 1 - f];
+      else {
+        if (i < g)
+          g = i;
+        f = i;
+        while (g >= 0 && P[g] == P[g + M - 1 - f])
+          g--;
+        sufijo[i] = f - g;
+      }
+    }
+
+    // Buen sufijo: bueno[i] es el salto si P[i+1..m-1] coincidió y P[i] no
+    this->bueno.assign(m, m);
+    size_t j = 0;
+    for (long i = M - 1; i >= 0; i--)
+      if (sufijo[i] == i + 1)
+        for (; j < m - 1 - i; j++)
+          if (this->bueno[j] == m)
+            this->bueno[j] = m - 1 - i;
+    for (long i = 0; i + 1 < M; i++)
+      this->bueno[m - 1 - sufijo[i]] = m - 1 - i;
+  }
+
+  void buscar(const char *T, size_t n, const callback_match &cb) const {
+    const size_t m = this->patron.size();
+    if (m == 0 || m > n)
+      return;
+    const char *P = this->patron.data();
+    size_t j = 0;
+    while (j <= n - m) {
+      long i = m - 1;
+      while (i >= 0 && P[i] == T[i + j])
+        i--;
+      if (i < 0) {
+        cb(j);
+        j += this->bueno[0];
+      } else {
+        // El mal carácter puede pedir retroceder: ahí manda el buen sufijo
+        long malo = (long)this->malo[(unsigned char)T[i + j]] - (long)(m - 1) + i;
+        j += std::max<long>(this->bueno[i], malo);
+      }
+    }
+  }
+
+private:
+  std::string patron;
+  size_t malo[256];
+  std::vector<size_t> bueno;
+};
+
+// Horspool: sólo la regla del mal carácter, tomada siempre del último byte
+// de la ventana. Menos preprocesamiento y un ciclo más simple que
+// Boyer-Moore; en texto natural suele ser igual o más rápido.
+class horspool {
+public:
+  horspool(const char *P, size_t m) : patron(P, m) {
+    for (int c = 0; c < 256; c++)
+      this->salto[c] = m;
+    for (size_t i = 0; i + 1 < m; i++)
+      this->salto[(unsigned char)P[i]] = m - 1 - i;
+  }
+
+  void buscar(const char *T, size_t n, const callback_match &cb) const {
+    const size_t m = this->patron.size();
+    if (m == 0 || m > n)
+      return;
+    const char *P = this->patron.data();
+    const char ultimo = P[m - 1];
+    size_t j = 0;
+    while (j <= n - m) {
+      const char c = T[j + m - 1];
+      if (c == ultimo && memcmp(T + j, P, m - 1) == 0)
+        cb(j);
+      j += this->salto[(unsigned char)c];
+    }
+  }
+
+private:
+  std::string patron;
+  size_t salto[256];
+};
+
+inline void boyer_moore_matcher(const char *T, size_t n, const char *P,
+                                size_t m, const callback_match &cb) {
+  boyer_moore(P, m).buscar(T, n, cb);
+}
+
+inline void horspool_matcher(const char *T, size_t n, const char *P, size_t m,
+                             const callback_match &cb) {
+  horspool(P, m).buscar(T, n, cb);
+}
+
+#endif // BOYER_MOORE_HPP
@@ -0,0 +1,208 @@
+#ifndef BUSQUEDA_APROXIMADA_HPP
+#define BUSQUEDA_APROXIMADA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <vector>
+
+#include "flujo.hpp"
+
+// Búsqueda aproximada con paralelismo de bits: cada fila de la tabla de
+// programación dinámica (una por byte del patrón) es un bit, y una columna
+// entera se actualiza con unas pocas operaciones sobre palabras de 64 bits.
+// Los patrones de más de 64 bytes usan varias palabras, con acarreo de una
+// a la siguiente. Como los buscadores exactos consumen el flujo de a
+// pedazos y el estado pasa de un pedazo al siguiente.
+
+// Bitap (Shift-And) con a lo sumo k sustituciones, sin inserciones ni
+// borrados. R[d] tiene el bit i prendido si P[0..i] coincide con los
+// últimos i+1 bytes con a lo sumo d diferencias. cb recibe el comienzo de
+// cada ventana de m bytes que difiere de P en a lo sumo k posiciones.
+// O(k * m / 64) por byte.
+class bitap_stream {
+public:
+  bitap_stream(const char *P, size_t m, size_t k, callback_match cb)
+      : m(m), k(k), cb(cb) {
+    this->palabras = (m + 63) / 64;
+    const size_t W = this->palabras;
+    this->B.assign(256 * W, 0);
+    for (size_t i = 0; i < m; i++)
+      this->B[(unsigned char)P[i] * W + i / 64] |= uint64_t(1) << (i % 64);
+    this->R.resize((k + 1) * W);
+    this->anterior.resize(W);
+    this->reset();
+  }
+
+  void reset() {
+    std::fill(this->R.begin(), this->R.end(), 0);
+    this->leidos = 0;
+  }
+
+  size_t offset() const { return this->leidos; }
+
+  void feed(const char *chunk, size_t len) {
+    if (this->m == 0)
+      return;
+    const size_t W = this->palabras;
+    const uint64_t ultimo = uint64_t(1) << ((this->m - 1) % 64);
+    uint64_t *previo = this->anterior.data();
+    for (size_t j = 0; j < len; j++) {
+      const uint64_t *b = &this->B[(unsigned char)chunk[j] * W];
+      // R[d] nuevo = (R[d] << 1 | 1) & b  |  (R[d-1] viejo << 1 | 1)
+      for (size_t d = 0; d <= this->k; d++) {
+        uint64_t *r = &this->R[d * W];
+        uint64_t acarreo = 1, acarreo_previo = 1;
+        for (size_t w = 0; w < W; w++) {
+          const uint64_t viejo = r[w];
+          uint64_t nuevo = ((viejo << 1) | acarreo) & b[w];
+          if (d > 0) {
+            nuevo |= (previo[w] << 1) | acarreo_previo;
+            acarreo_previo = previo[w] >> 63;
+          }
+          acarreo = viejo >> 63;
+          previo[w] = viejo;
+          r[w] = nuevo;
+        }
+      }
+      this->leidos++;
+      if (this->R[this->k * W + W - 1] & ultimo)
+        this->cb(this->leidos - this->m);
+    }
+  }
+
+private:
+  size_t m;
+  size_t k;
+  callback_match cb;
+  size_t palabras;
+  std::vector<uint64_t> B;        // 256 x palabras: dónde aparece cada byte en P
+  std::vector<uint64_t> R;        // (k+1) x palabras
+  std::vector<uint64_t> anterior; // R[d-1] antes de actualizarlo
+  size_t leidos;
+};
+
+// Myers (con los bloques de Hyyrö para m > 64): distancia de edición con
+// inserciones, borrados y sustituciones. Guarda las diferencias verticales
+// de la columna (Pv: +1, Mv: -1) y lleva aparte el valor de la última fila,
+// la distancia de P a la mejor subcadena que termina en el byte actual.
+// cb recibe el final (exclusivo) de cada subcadena a distancia <= k; una
+// ocurrencia aproximada suele informarse en varios finales seguidos.
+// O(m / 64) por byte.
+class myers_stream {
+public:
+  myers_stream(const char *P, size_t m, size_t k, callback_match cb)
+      : m(m), k(k), cb(cb) {
+    this->palabras = (m + 63) / 64;
+    const size_t W = this->palabras;
+    this->Peq.assign(256 * W, 0);
+    for (size_t i = 0; i < m; i++)
+      this->Peq[(unsigned char)P[i] * W + i / 64] |= uint64_t(1) << (i % 64);
+    this->Pv.resize(W);
+    this->Mv.resize(W);
+    this->reset();
+  }
+
+  void reset() {
+    std::fill(this->Pv.begin(), this->Pv.end(), ~uint64_t(0));
+    std::fill(this->Mv.begin(), this->Mv.end(), 0);
+    this->distancia = this->m;
+    this->leidos = 0;
+  }
+
+  size_t offset() const { return this->leidos; }
+
+  void feed(const char *chunk, size_t len) {
+    if (this->m == 0)
+      return;
+    const size_t W = this->palabras;
+    const uint64_t ultimo = uint64_t(1) << ((this->m - 1) % 64);
+    const uint64_t alto = uint64_t(1) << 63;
+    for (size_t j = 0; j < len; j++) {
+      const uint64_t *eq = &this->Peq[(unsigned char)chunk[j] * W];
+      // Diferencia horizontal que entra por abajo de cada bloque; arriba de
+      // todo es 0 porque la ocurrencia puede empezar en cualquier lado
+      int h = 0;
+      for (size_t w = 0; w < W; w++) {
+        uint64_t pv = this->Pv[w], mv = this->Mv[w];
+        uint64_t Eq = eq[w];
+        const uint64_t Xv = Eq | mv;
+        if (h < 0)
+          Eq |= 1;
+        const uint64_t Xh = (((Eq & pv) + pv) ^ pv) | Eq;
+        uint64_t Ph = mv | ~(Xh | pv);
+        uint64_t Mh = pv & Xh;
+        if (w == W - 1) {
+          if (Ph & ultimo)
+            this->distancia++;
+          else if (Mh & ultimo)
+            this->distancia--;
+        }
+        const int sale = (Ph & alto) ? 1 : (Mh & alto) ? -1 : 0;
+        Ph <<= 1;
+        Mh <<= 1;
+        if (h < 0)
+          Mh |= 1;
+        else if (h > 0)
+          Ph |= 1;
+        this->Pv[w] = Mh | ~(Xv | Ph);
+        this->Mv[w] = Ph & Xv;
+        h = sale;
+      }
+      this->leidos++;
+      if (this->distancia <= this->k)
+        this->cb(this->leidos);
+    }
+  }
+
+private:
+  size_t m;
+  size_t k;
+  callback_match cb;
+  size_t palabras;
+  std::vector<uint64_t> Peq; // 256 x palabras: dónde aparece cada byte en P
+  std::vector<uint64_t> Pv;
+  std::vector<uint64_t> Mv;
+  size_t distancia;          // de P a la mejor subcadena que termina acá
+  size_t leidos;
+};
+
+// Ventanas de T a distancia de Hamming <= k de P, por su comienzo
+inline void bitap_matcher(const char *T, size_t n, const char *P, size_t m,
+                          size_t k, const callback_match &cb) {
+  bitap_stream buscador(P, m, k, cb);
+  buscador.feed(T, n);
+}
+
+// Subcadenas de T a distancia de edición <= k de P, por su final
+inline void myers_matcher(const char *T, size_t n, const char *P, size_t m,
+                          size_t k, const callback_match &cb) {
+  myers_stream buscador(P, m, k, cb);
+  buscador.feed(T, n);
+}
+
+inline bool bitap_fd(int fd, const char *P, size_t m, size_t k,
+                     const callback_match &cb) {
+  bitap_stream buscador(P, m, k, cb);
+  return stream_fd(fd, buscador);
+}
+
+inline bool bitap_file(const char *ruta, const char *P, size_t m, size_t k,
+                       const callback_match &cb) {
+  bitap_stream buscador(P, m, k, cb);
+  return stream_file(ruta, buscador);
+}
+
+inline bool myers_fd(int fd, const char *P, size_t m, size_t k,
+                     const callback_match &cb) {
+  myers_stream buscador(P, m, k, cb);
+  return stream_fd(fd, buscador);
+}
+
+inline bool myers_file(const char *ruta, const char *P, size_t m, size_t k,
+                       const callback_match &cb) {
+  myers_stream buscador(P, m, k, cb);
+  return stream_file(ruta, buscador);
+}
+
+#endif // BUSQUEDA_APROXIMADA_HPP
@@ -0,0 +1,114 @@
+#ifndef BUSQUEDA_PARALELA_HPP
+#define BUSQUEDA_PARALELA_HPP
+
+#include <cstddef>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "flujo.hpp"
+
+// Busca P en T repartiendo el texto en pedazos entre varios hilos. matcher
+// es cualquier función con la forma de rabin_karp_matcher (T, n, P, m, cb):
+// rabin_karp_matcher, automata_matcher, simd_matcher, ...
+//
+// El pedazo k es responsable de las ocurrencias que empiezan en
+// [k * pedazo, (k+1) * pedazo) y se le pasan además los m-1 bytes
+// siguientes, para que vea enteras las que cruzan el borde. Como ninguna
+// ocurrencia empieza en dos pedazos no hay repetidas.
+//
+// Cada hilo toma el próximo pedazo libre y guarda sus desplazamientos.
+// Cuando terminan los pedazos 0..k se informan en orden y se liberan, así
+// la salida empieza enseguida. Además nunca hay más de 4 pedazos por hilo
+// entre el primero sin informar y el próximo a tomar: lo guardado queda
+// acotado aunque un pedazo lento retrase a los demás. cb se llama desde
+// los hilos, pero de a uno por vez y siempre en orden.
+//
+// hilos <= 0: todos los núcleos. pedazo == 0: 4 MB.
+template <class F>
+void parallel_matcher(const char *T, size_t n, const char *P, size_t m,
+                      const callback_match &cb, F matcher, int hilos = 0,
+                      size_t pedazo = 0) {
+  if (m == 0 || m > n)
+    return;
+  if (pedazo == 0)
+    pedazo = 1 << 22;
+  const size_t posiciones = n - m + 1; // donde puede empezar una ocurrencia
+  const size_t pedazos = (posiciones + pedazo - 1) / pedazo;
+  if (hilos <= 0)
+    hilos = std::thread::hardware_concurrency();
+  hilos = std::max(1, (int)std::min<size_t>(hilos, pedazos));
+  const size_t en_vuelo = 4 * hilos;
+
+  std::vector<std::vector<size_t>> encontrados(pedazos);
+  std::vector<char> terminado(pedazos, 0);
+  size_t proximo = 0;  // el próximo pedazo a tomar
+  size_t informar = 0; // el primero que todavía no se informó
+  std::mutex mutex;
+  std::condition_variable avance;
+  auto trabajar = [&]() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      avance.wait(lock, [&]() {
+        return proximo >= pedazos || proximo < informar + en_vuelo;
+      });
+      if (proximo >= pedazos)
+        return;
+      const size_t k = proximo++;
+      lock.unlock();
+
+      const size_t desde = k * pedazo;
+      const size_t hasta = std::min(desde + pedazo, posiciones);
+      std::vector<size_t> &propios = encontrados[k];
+      matcher(T + desde, hasta - desde + m - 1, P, m,
+              [&](size_t i) { propios.push_back(desde + i); });
+
+      lock.lock();
+      terminado[k] = 1;
+      for (; informar < pedazos && terminado[informar]; informar++) {
+        for (size_t j = 0; j < encontrados[informar].size(); j++)
+          cb(encontrados[informar][j]);
+        std::vector<size_t>().swap(encontrados[informar]);
+      }
+      avance.notify_all();
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int id = 1; id < hilos; id++)
+    threads.push_back(std::thread(trabajar));
+  trabajar();
+  for (size_t t = 0; t < threads.size(); t++)
+    threads[t].join();
+}
+
+// Lo mismo sobre un archivo, mapeado en memoria. Devuelve false si no se
+// puede abrir o mapear (pipes, por ejemplo: para esos está stream_fd).
+template <class F>
+bool parallel_file(const char *ruta, const char *P, size_t m,
+                   const callback_match &cb, F matcher, int hilos = 0,
+                   size_t pedazo = 0) {
+  int fd = open(ruta, O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat info;
+  if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+    close(fd);
+    return false;
+  }
+  if (info.st_size == 0) {
+    close(fd);
+    return true;
+  }
+  void *mapa = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapa == MAP_FAILED)
+    return false;
+  parallel_matcher((const char *)mapa, info.st_size, P, m, cb, matcher, hilos,
+                   pedazo);
+  munmap(mapa, info.st_size);
+  return true;
+}
+
+#endif // BUSQUEDA_PARALELA_HPP
@@ -0,0 +1,128 @@
+#ifndef BUSQUEDA_SIMD_HPP
+#define BUSQUEDA_SIMD_HPP
+
+#include <cstddef>
+#include <cstring>
+
+#include "flujo.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BUSQUEDA_SIMD_X86 1
+#endif
+
+// Búsqueda exacta comparando de a 16 o 32 posiciones a la vez el primer y
+// el último byte del patrón: T[i] == P[0] y T[i+m-1] == P[m-1] para todas
+// las i del bloque con dos comparaciones de vectores. Sólo las posiciones
+// que pasan ese filtro se verifican con memcmp; con patrones cortos y
+// bytes no demasiado frecuentes son pocas.
+//
+// La implementación (AVX2, SSE2 o escalar) se elige una vez, al primer uso,
+// según lo que soporte el procesador.
+
+// Verifica el medio: los extremos ya coinciden
+inline bool simd_coincide(const char *T, const char *P, size_t m) {
+  return m <= 2 || memcmp(T + 1, P + 1, m - 2) == 0;
+}
+
+// Desde la posición i hasta el final, sin vectores
+inline void simd_escalar(const char *T, size_t n, const char *P, size_t m,
+                         size_t i, const callback_match &cb) {
+  const char *fin = T + n - m + 1; // una más que la última posición posible
+  const char *t = T + i;
+  while (t < fin) {
+    t = (const char *)memchr(t, P[0], fin - t);
+    if (t == nullptr)
+      return;
+    if (t[m - 1] == P[m - 1] && simd_coincide(t, P, m))
+      cb(t - T);
+    t++;
+  }
+}
+
+#ifdef BUSQUEDA_SIMD_X86
+
+__attribute__((target("sse2"))) inline void
+simd_sse2(const char *T, size_t n, const char *P, size_t m,
+          const callback_match &cb) {
+  const __m128i primero = _mm_set1_epi8(P[0]);
+  const __m128i ultimo = _mm_set1_epi8(P[m - 1]);
+  size_t i = 0;
+  for (; i + m - 1 + 16 <= n; i += 16) {
+    __m128i a = _mm_loadu_si128((const __m128i *)(T + i));
+    __m128i b = _mm_loadu_si128((const __m128i *)(T + i + m - 1));
+    unsigned mascara = _mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(a, primero), _mm_cmpeq_epi8(b, ultimo)));
+    while (mascara != 0) {
+      size_t j = i + __builtin_ctz(mascara);
+      if (simd_coincide(T + j, P, m))
+        cb(j);
+      mascara &= mascara - 1;
+    }
+  }
+  simd_escalar(T, n, P, m, i, cb);
+}
+
+__attribute__((target("avx2"))) inline void
+simd_avx2(const char *T, size_t n, const char *P, size_t m,
+          const callback_match &cb) {
+  const __m256i primero = _mm256_set1_epi8(P[0]);
+  const __m256i ultimo = _mm256_set1_epi8(P[m - 1]);
+  size_t i = 0;
+  for (; i + m - 1 + 32 <= n; i += 32) {
+    __m256i a = _mm256_loadu_si256((const __m256i *)(T + i));
+    __m256i b = _mm256_loadu_si256((const __m256i *)(T + i + m - 1));
+    unsigned mascara = _mm256_movemask_epi8(_mm256_and_si256(
+        _mm256_cmpeq_epi8(a, primero), _mm256_cmpeq_epi8(b, ultimo)));
+    while (mascara != 0) {
+      size_t j = i + __builtin_ctz(mascara);
+      if (simd_coincide(T + j, P, m))
+        cb(j);
+      mascara &= mascara - 1;
+    }
+  }
+  simd_escalar(T, n, P, m, i, cb);
+}
+
+#endif // BUSQUEDA_SIMD_X86
+
+inline void simd_sin_vectores(const char *T, size_t n, const char *P, size_t m,
+                              const callback_match &cb) {
+  simd_escalar(T, n, P, m, 0, cb);
+}
+
+typedef void (*funcion_busqueda)(const char *, size_t, const char *, size_t,
+                                 const callback_match &);
+
+// "avx2", "sse2" o "escalar": la que usa simd_matcher en esta máquina
+inline const char *simd_implementacion() {
+#ifdef BUSQUEDA_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return "avx2";
+  if (__builtin_cpu_supports("sse2"))
+    return "sse2";
+#endif
+  return "escalar";
+}
+
+// Busca P (de largo m) en T (de largo n), como rabin_karp_matcher
+inline void simd_matcher(const char *T, size_t n, const char *P, size_t m,
+                         const callback_match &cb) {
+  static const funcion_busqueda elegida = []() -> funcion_busqueda {
+    const char *nombre = simd_implementacion();
+#ifdef BUSQUEDA_SIMD_X86
+    if (strcmp(nombre, "avx2") == 0)
+      return simd_avx2;
+    if (strcmp(nombre, "sse2") == 0)
+      return simd_sse2;
+#endif
+    (void)nombre;
+    return simd_sin_vectores;
+  }();
+  if (m == 0 || m > n)
+    return;
+  elegida(T, n, P, m, cb);
+}
+
+#endif // BUSQUEDA_SIMD_HPP
@@ -0,0 +1,60 @@
+#ifndef FLUJO_HPP
+#define FLUJO_HPP
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Lo que comparten los buscadores que consumen el texto de a pedazos: cada
+// uno tiene feed(pedazo, largo) y avisa las ocurrencias por un callback.
+
+// Se llama con el desplazamiento de cada ocurrencia desde el principio del
+// texto (o del flujo)
+typedef std::function<void(size_t)> callback_match;
+// Para varios patrones: desplazamiento e índice del patrón encontrado
+typedef std::function<void(size_t, size_t)> callback_multi;
+
+// Pasa todo lo que se lee de fd, de a bloques, a buscador.feed (sirve para
+// pipes y stdin). Devuelve false si falla una lectura.
+template <class S>
+bool stream_fd(int fd, S &buscador, size_t bloque = 1 << 16) {
+  std::vector<char> buffer(bloque);
+  while (true) {
+    ssize_t leidos = read(fd, buffer.data(), buffer.size());
+    if (leidos == 0)
+      return true;
+    if (leidos < 0)
+      return false;
+    buscador.feed(buffer.data(), leidos);
+  }
+}
+
+// Pasa un archivo a buscador.feed mapeándolo en memoria; si no se puede
+// mapear (vacío, pipe con nombre, ...) lo lee de a bloques. Devuelve false
+// si no se puede abrir o leer.
+template <class S> bool stream_file(const char *ruta, S &buscador) {
+  int fd = open(ruta, O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat info;
+  bool ok;
+  void *mapa = MAP_FAILED;
+  if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)
+    mapa = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (mapa != MAP_FAILED) {
+    madvise(mapa, info.st_size, MADV_SEQUENTIAL);
+    buscador.feed((const char *)mapa, info.st_size);
+    munmap(mapa, info.st_size);
+    ok = true;
+  } else
+    ok = stream_fd(fd, buscador);
+  close(fd);
+  return ok;
+}
+
+#endif // FLUJO_HPP
@@ -0,0 +1,84 @@
+#ifndef MATCHER_HPP
+#define MATCHER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "automata_finito.hpp"
+#include "boyer_moore.hpp"
+#include "busqueda_simd.hpp"
+#include "flujo.hpp"
+#include "rabin_karp.hpp"
+#include "two_way.hpp"
+
+// Interfaz común a los algoritmos de búsqueda exacta de un patrón, para
+// elegir el algoritmo por patrón sin cambiar el código que busca. Se arma
+// con crear_matcher y sirve para muchos textos.
+class matcher {
+public:
+  virtual ~matcher() {}
+  // Informa con cb el desplazamiento de cada ocurrencia del patrón en T
+  virtual void buscar(const char *T, size_t n, const callback_match &cb) const = 0;
+};
+
+enum algoritmo_busqueda {
+  RABIN_KARP,
+  AUTOMATA,
+  SIMD,
+  BOYER_MOORE,
+  HORSPOOL,
+  TWO_WAY
+};
+
+// Para boyer_moore, horspool y two_way, que preprocesan el patrón una vez
+template <class B> class matcher_de : public matcher {
+public:
+  matcher_de(const char *P, size_t m) : buscador(P, m) {}
+  void buscar(const char *T, size_t n, const callback_match &cb) const {
+    this->buscador.buscar(T, n, cb);
+  }
+
+private:
+  B buscador;
+};
+
+// Para las funciones con la forma de rabin_karp_matcher. Se guarda una copia
+// del patrón; el preprocesamiento se repite en cada búsqueda.
+class matcher_funcion : public matcher {
+public:
+  typedef void (*funcion)(const char *, size_t, const char *, size_t,
+                          const callback_match &);
+
+  matcher_funcion(funcion f, const char *P, size_t m) : f(f), patron(P, m) {}
+  void buscar(const char *T, size_t n, const callback_match &cb) const {
+    this->f(T, n, this->patron.data(), this->patron.size(), cb);
+  }
+
+private:
+  funcion f;
+  std::string patron;
+};
+
+inline std::unique_ptr<matcher> crear_matcher(algoritmo_busqueda algoritmo,
+                                              const char *P, size_t m) {
+  switch (algoritmo) {
+  case RABIN_KARP:
+    return std::unique_ptr<matcher>(
+        new matcher_funcion(rabin_karp_matcher, P, m));
+  case AUTOMATA:
+    return std::unique_ptr<matcher>(
+        new matcher_funcion(automata_matcher, P, m));
+  case SIMD:
+    return std::unique_ptr<matcher>(new matcher_funcion(simd_matcher, P, m));
+  case BOYER_MOORE:
+    return std::unique_ptr<matcher>(new matcher_de<boyer_moore>(P, m));
+  case HORSPOOL:
+    return std::unique_ptr<matcher>(new matcher_de<horspool>(P, m));
+  case TWO_WAY:
+    return std::unique_ptr<matcher>(new matcher_de<two_way>(P, m));
+  }
+  return nullptr;
+}
+
+#endif // MATCHER_HPP
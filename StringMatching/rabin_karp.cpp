@@ -1,47 +1,160 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
-#include <cmath>
-#include <bits/stdc++.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "busqueda_aproximada.hpp"
+#include "busqueda_paralela.hpp"
+#include "matcher.hpp"
+#include "rabin_karp.hpp"
 
 using namespace std;
-using std::pow;
-
-// d tiene que ser un número mayor a la cantidad de caracteres del lenguaje
-#define d 256
-
-// q tiene que ser un número primo
-void rabin_karp_matcher(char T[],char P[],int q) {
-    
-    int h_t = 0; // hash de texto T
-    int h_p = 0; // hash de patron P
-    int m = strlen(P); // tamaño de P
-    int n = strlen(T); // tamaño de T
-    int h=1; 
-    
-    // pow(d,M-1) % q
-    for (int i = 0; i < m - 1; i++)
-        h = (h * d) % q;
-
-    // rolling hashing
-    for (int i=0; i<m; i++){
-      h_t =(d * h_t + T[i]) % q;
-      h_p =( d * h_p + P[i]) % q ;
+
+// Los valores de -a
+static bool algoritmo_por_nombre(const char *nombre,
+                                 algoritmo_busqueda &algoritmo) {
+  static const struct {
+    const char *nombre;
+    algoritmo_busqueda algoritmo;
+  } nombres[] = {{"rk", RABIN_KARP},      {"dfa", AUTOMATA},
+                 {"simd", SIMD},          {"bm", BOYER_MOORE},
+                 {"horspool", HORSPOOL},  {"twoway", TWO_WAY}};
+  for (size_t i = 0; i < sizeof(nombres) / sizeof(nombres[0]); i++)
+    if (strcmp(nombre, nombres[i].nombre) == 0) {
+      algoritmo = nombres[i].algoritmo;
+      return true;
     }
-   
-   // busqueda
-   for (int i=0;i<n-m;i++){
-      if (h_t == h_p) {
-        cout << "Matching con desplazamiento: " << i << endl;
-      }
-      if (i<n-m){
-        h_t = (d*(h_t - T[i]*(int)h) + T[i+m])%q;
-        if (h_t<0)
-          h_t=h_t+q;
-		}
-	}
+  return false;
 }
 
-int main () {
-  char T[10] = "holamundo";
-  char P[6] = "mundo";
-  rabin_karp_matcher(T,P,101);
+// Para pipes y la entrada estándar, que no se pueden mapear: se lee todo fd
+// a memoria
+static bool leer_todo(int fd, string &texto) {
+  char buffer[1 << 16];
+  while (true) {
+    ssize_t leidos = read(fd, buffer, sizeof(buffer));
+    if (leidos == 0)
+      return true;
+    if (leidos < 0)
+      return false;
+    texto.append(buffer, leidos);
+  }
+}
+
+// Sin argumentos busca "mundo" en "holamundo". Con argumentos:
+//   rabin_karp [-a ALGORITMO] [-j HILOS] PATRON [ARCHIVO]
+//   rabin_karp -f PATRONES [ARCHIVO]   (un patrón por línea)
+//   rabin_karp -k N PATRON [ARCHIVO]   (a lo sumo N sustituciones, Bitap)
+//   rabin_karp -e N PATRON [ARCHIVO]   (distancia de edición <= N, Myers)
+// busca en ARCHIVO, o en la entrada estándar si no se da. Sin opciones el
+// patrón se busca con Rabin-Karp de a pedazos. Con -a se elige el
+// algoritmo por crear_matcher (rk, dfa, simd, bm, horspool o twoway);
+// simd usa AVX2, SSE2 o ninguno según el procesador. Con -j el texto se
+// reparte entre HILOS hilos (0: todos los núcleos) con parallel_file. Con
+// cualquiera de las dos el archivo se mapea; la entrada estándar se lee
+// entera a memoria.
+//
+// Ojo con los desplazamientos de la búsqueda aproximada: -k informa dónde
+// EMPIEZA cada ventana de largo |PATRON| (como la búsqueda exacta), pero -e
+// informa dónde TERMINA cada subcadena (la posición siguiente al último
+// byte), porque con inserciones y borrados el largo no es fijo. Una misma
+// ocurrencia con -e suele aparecer en varios finales seguidos.
+int main(int argc, char *argv[]) {
+  callback_match mostrar = [](size_t i) {
+    cout << "Matching con desplazamiento: " << i << endl;
+  };
+
+  if (argc < 2) {
+    const char T[] = "holamundo";
+    const char P[] = "mundo";
+    rabin_karp_matcher(T, strlen(T), P, strlen(P), mostrar);
+    return 0;
+  }
+
+  // Opciones, cada una con su valor, antes del patrón
+  const char *algoritmo = nullptr;
+  int hilos = -1; // sin -j
+  const char *sustituciones = nullptr, *ediciones = nullptr;
+  int i = 1;
+  for (; i + 2 < argc; i += 2) {
+    if (strcmp(argv[i], "-a") == 0)
+      algoritmo = argv[i + 1];
+    else if (strcmp(argv[i], "-j") == 0)
+      hilos = atoi(argv[i + 1]);
+    else if (strcmp(argv[i], "-k") == 0)
+      sustituciones = argv[i + 1];
+    else if (strcmp(argv[i], "-e") == 0)
+      ediciones = argv[i + 1];
+    else
+      break;
+  }
+
+  bool ok;
+  const char *archivo;
+  if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+    ifstream lista(argv[i + 1]);
+    vector<string> patrones;
+    string linea;
+    while (getline(lista, linea))
+      patrones.push_back(linea);
+    rabin_karp_multi<> buscador(patrones, [&](size_t i, size_t k) {
+      cout << "Matching de \"" << patrones[k] << "\" con desplazamiento: " << i
+           << endl;
+    });
+    archivo = i + 2 < argc ? argv[i + 2] : nullptr;
+    ok = archivo ? stream_file(archivo, buscador) : stream_fd(0, buscador);
+  } else if (sustituciones || ediciones) {
+    const char *P = argv[i];
+    archivo = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (sustituciones) {
+      const size_t k = strtoul(sustituciones, nullptr, 10);
+      ok = archivo ? bitap_file(archivo, P, strlen(P), k, mostrar)
+                   : bitap_fd(0, P, strlen(P), k, mostrar);
+    } else {
+      callback_match mostrar_final = [](size_t fin) {
+        cout << "Matching que termina en: " << fin << endl;
+      };
+      const size_t k = strtoul(ediciones, nullptr, 10);
+      ok = archivo ? myers_file(archivo, P, strlen(P), k, mostrar_final)
+                   : myers_fd(0, P, strlen(P), k, mostrar_final);
+    }
+  } else if (algoritmo || hilos >= 0) {
+    algoritmo_busqueda elegido = RABIN_KARP;
+    if (algoritmo && !algoritmo_por_nombre(algoritmo, elegido)) {
+      cerr << "Algoritmo desconocido: " << algoritmo << endl;
+      return 1;
+    }
+    if (hilos < 0)
+      hilos = 1;
+    const char *P = argv[i];
+    const size_t m = strlen(P);
+    unique_ptr<matcher> M = crear_matcher(elegido, P, m);
+    auto buscar = [&](const char *T, size_t n, const char *, size_t,
+                      const callback_match &cb) { M->buscar(T, n, cb); };
+    archivo = i + 1 < argc ? argv[i + 1] : nullptr;
+    ok = archivo && parallel_file(archivo, P, m, mostrar, buscar, hilos);
+    if (!ok) {
+      int fd = archivo ? open(archivo, O_RDONLY) : 0;
+      string texto;
+      ok = fd >= 0 && leer_todo(fd, texto);
+      if (archivo && fd >= 0)
+        close(fd);
+      if (ok)
+        parallel_matcher(texto.data(), texto.size(), P, m, mostrar, buscar,
+                         hilos);
+    }
+  } else {
+    const char *P = argv[i];
+    archivo = i + 1 < argc ? argv[i + 1] : nullptr;
+    ok = archivo ? rabin_karp_file(archivo, P, strlen(P), mostrar)
+                 : rabin_karp_fd(0, P, strlen(P), mostrar);
+  }
+  if (!ok) {
+    cerr << "No se pudo leer " << (archivo ? archivo : "la entrada") << endl;
+    return 1;
+  }
+  return 0;
 }
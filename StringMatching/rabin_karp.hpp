@@ -0,0 +1,377 @@
+#ifndef RABIN_KARP_HPP
+#define RABIN_KARP_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "flujo.hpp"
+
+// Hashes rodantes. Cada uno se arma para un largo de ventana y sabe agregar
+// un byte al final (agregar) o además sacar el primero (rodar). El hash de
+// una cadena c_0..c_{m-1} es sum c_i * BASE^(m-1-i) módulo un primo.
+
+// Módulo el primo de Mersenne 2^61 - 1. El producto de 128 bits se reduce con
+// una suma y un desplazamiento, sin divisiones ni desbordes. Dos ventanas
+// distintas chocan con probabilidad ~ m / 2^61, así que casi nunca hace
+// falta verificar un candidato que no es ocurrencia.
+class hash_mersenne {
+public:
+  typedef uint64_t valor;
+  static const uint64_t MOD = (uint64_t(1) << 61) - 1;
+  static const uint64_t BASE = 0x1b873593a5e31f6bULL % MOD;
+
+  explicit hash_mersenne(size_t largo) {
+    uint64_t h = 1; // BASE^(largo-1)
+    for (size_t i = 1; i < largo; i++)
+      h = mul(h, BASE);
+    for (int c = 0; c < 256; c++)
+      this->sale[c] = mul(c, h);
+  }
+
+  static valor vacio() { return 0; }
+  valor agregar(valor h, unsigned char c) const {
+    return reducir(mul(h, BASE) + c);
+  }
+  valor rodar(valor h, unsigned char viejo, unsigned char entra) const {
+    return this->agregar(h >= this->sale[viejo] ? h - this->sale[viejo]
+                                                 : h + MOD - this->sale[viejo],
+                         entra);
+  }
+  // 64 bits para indexar tablas
+  static uint64_t clave(valor h) { return h; }
+
+  static uint64_t mul(uint64_t a, uint64_t b) {
+    __uint128_t p = (__uint128_t)a * b;
+    return reducir((uint64_t)(p & MOD) + (uint64_t)(p >> 61));
+  }
+
+private:
+  uint64_t sale[256]; // c * BASE^(largo-1)
+
+  // x < 2 MOD
+  static uint64_t reducir(uint64_t x) { return x >= MOD ? x - MOD : x; }
+};
+
+// Dos hashes independientes, módulo 2^61 - 1 y módulo 2^31 - 1 (también de
+// Mersenne, también sin divisiones): ~92 bits. Para cuando un falso
+// candidato es caro o el texto puede ser adversario.
+class hash_doble {
+public:
+  struct valor {
+    uint64_t a, b;
+    bool operator==(const valor &otro) const {
+      return this->a == otro.a && this->b == otro.b;
+    }
+    bool operator!=(const valor &otro) const { return !(*this == otro); }
+    bool operator<(const valor &otro) const {
+      return this->a < otro.a || (this->a == otro.a && this->b < otro.b);
+    }
+  };
+  static const uint64_t MOD31 = (uint64_t(1) << 31) - 1;
+  static const uint64_t BASE31 = 0x2f6b1d35 % MOD31;
+
+  explicit hash_doble(size_t largo) : primero(largo) {
+    uint64_t h = 1;
+    for (size_t i = 1; i < largo; i++)
+      h = mul31(h, BASE31);
+    for (int c = 0; c < 256; c++)
+      this->sale[c] = mul31(c, h);
+  }
+
+  static valor vacio() { return valor{0, 0}; }
+  valor agregar(valor h, unsigned char c) const {
+    return valor{this->primero.agregar(h.a, c), reducir31(mul31(h.b, BASE31) + c)};
+  }
+  valor rodar(valor h, unsigned char viejo, unsigned char entra) const {
+    uint64_t b = h.b >= this->sale[viejo] ? h.b - this->sale[viejo]
+                                          : h.b + MOD31 - this->sale[viejo];
+    return valor{this->primero.rodar(h.a, viejo, entra),
+                 reducir31(mul31(b, BASE31) + entra)};
+  }
+  static uint64_t clave(valor h) { return h.a ^ (h.b << 32); }
+
+private:
+  hash_mersenne primero;
+  uint64_t sale[256];
+
+  static uint64_t reducir31(uint64_t x) { return x >= MOD31 ? x - MOD31 : x; }
+  // a, b < 2^31: el producto entra en 64 bits
+  static uint64_t mul31(uint64_t a, uint64_t b) {
+    uint64_t p = a * b;
+    return reducir31((p & MOD31) + (p >> 31));
+  }
+};
+
+// Rabin-Karp sobre un flujo que llega de a pedazos: el hash rodante y los
+// últimos m bytes pasan de un pedazo al siguiente, así que una ocurrencia
+// partida entre dos pedazos se encuentra igual. Cada candidato (hash igual)
+// se verifica byte a byte antes de informarlo.
+template <class H = hash_mersenne> class rabin_karp_stream {
+public:
+  rabin_karp_stream(const char *P, size_t m, callback_match cb)
+      : patron(P, m), cb(cb), hash(m) {
+    this->h_p = H::vacio();
+    for (size_t i = 0; i < m; i++)
+      this->h_p = this->hash.agregar(this->h_p, P[i]);
+    this->ventana.resize(m);
+    this->reset();
+  }
+
+  // Vuelve al principio del flujo (el patrón se conserva)
+  void reset() {
+    this->h_t = H::vacio();
+    this->leidos = 0;
+  }
+
+  // Bytes consumidos hasta ahora
+  size_t offset() const { return this->leidos; }
+
+  // Consume un pedazo del flujo. O(len) más O(m) por candidato
+  void feed(const char *chunk, size_t len) {
+    const size_t m = this->patron.size();
+    if (m == 0)
+      return;
+    const unsigned char *T = (const unsigned char *)chunk;
+    size_t i = 0;
+    // Mientras la ventana no se llenó no sale ningún byte
+    for (; i < len && this->leidos < m; i++) {
+      this->h_t = this->hash.agregar(this->h_t, T[i]);
+      this->ventana[this->leidos % m] = T[i];
+      this->leidos++;
+      if (this->leidos == m)
+        this->candidato(chunk, i + 1);
+    }
+    // El que sale viene de la ventana hasta que el pedazo tiene m bytes
+    const size_t inicio = this->leidos - i; // posición en el flujo de chunk[0]
+    for (; i < len && i < m; i++) {
+      this->rodar(this->ventana[(inicio + i) % m], T[i]);
+      this->candidato(chunk, i + 1);
+    }
+    for (; i < len; i++) {
+      this->rodar(T[i - m], T[i]);
+      this->candidato(chunk, i + 1);
+    }
+    // Guardar los últimos m bytes para el próximo pedazo
+    for (size_t j = len > m ? len - m : 0; j < len; j++)
+      this->ventana[(inicio + j) % m] = T[j];
+  }
+
+private:
+  std::string patron;
+  callback_match cb;
+  H hash;
+  typename H::valor h_p; // hash del patrón
+  typename H::valor h_t; // hash de los últimos m bytes
+  size_t leidos;
+  std::vector<unsigned char> ventana; // últimos m bytes, circular
+
+  void rodar(unsigned char viejo, unsigned char entra) {
+    this->h_t = this->hash.rodar(this->h_t, viejo, entra);
+    this->leidos++;
+  }
+
+  // La ventana termina en chunk[fin-1]; si empieza antes del pedazo, esos
+  // primeros bytes todavía están en la ventana circular.
+  void candidato(const char *chunk, size_t fin) {
+    if (this->h_t != this->h_p)
+      return;
+    const size_t m = this->patron.size();
+    const size_t desde = this->leidos - m; // posición en el flujo
+    bool igual = true;
+    size_t k = 0;
+    for (; k + fin < m && igual; k++)
+      igual = this->ventana[(desde + k) % m] == (unsigned char)this->patron[k];
+    igual = igual && memcmp(chunk + fin + k - m, this->patron.data() + k,
+                            m - k) == 0;
+    if (igual)
+      this->cb(desde);
+  }
+};
+
+// Busca P (de largo m) en T (de largo n); no hace falta que terminen en '\0'
+inline void rabin_karp_matcher(const char *T, size_t n, const char *P,
+                               size_t m, const callback_match &cb) {
+  rabin_karp_stream<> buscador(P, m, cb);
+  buscador.feed(T, n);
+}
+
+// Rabin-Karp con muchos patrones en una sola pasada. Los patrones se agrupan
+// por largo; cada grupo lleva su propio hash rodante y busca el hash de la
+// ventana en una tabla plana (direccionamiento abierto) con los hashes de
+// sus patrones. El costo por byte es O(cantidad de largos distintos), no de
+// patrones. Como rabin_karp_stream, consume el flujo de a pedazos.
+template <class H = hash_mersenne> class rabin_karp_multi {
+public:
+  rabin_karp_multi(const std::vector<std::string> &patrones, callback_multi cb)
+      : patrones(patrones), cb(cb), largo_max(0) {
+    std::map<size_t, std::vector<size_t>> por_largo;
+    for (size_t k = 0; k < patrones.size(); k++)
+      if (!patrones[k].empty())
+        por_largo[patrones[k].size()].push_back(k);
+    for (std::map<size_t, std::vector<size_t>>::const_iterator it =
+             por_largo.begin();
+         it != por_largo.end(); it++)
+      this->grupos.push_back(this->armar_grupo(it->first, it->second));
+    if (!por_largo.empty())
+      this->largo_max = por_largo.rbegin()->first;
+    this->reset();
+  }
+
+  void reset() {
+    this->leidos = 0;
+    this->cola.clear();
+    this->cola.reserve(2 * this->largo_max);
+    for (size_t g = 0; g < this->grupos.size(); g++)
+      this->grupos[g].h_t = H::vacio();
+  }
+
+  size_t offset() const { return this->leidos; }
+
+  // Sólo se guardan los últimos largo_max bytes de los pedazos anteriores
+  // (cola). Los primeros largo_max bytes del pedazo se procesan pegados a
+  // la cola, porque sus ventanas (o el byte que sale de ellas) empiezan
+  // antes del pedazo; el resto se procesa directamente sobre el pedazo, sin
+  // copiarlo. Así un archivo mapeado entero en un solo pedazo no se copia.
+  void feed(const char *chunk, size_t len) {
+    if (this->grupos.empty() || len == 0)
+      return;
+    const unsigned char *C = (const unsigned char *)chunk;
+    const size_t L = this->largo_max;
+    const size_t p = std::min(len, L);
+    const size_t antes = this->cola.size();
+    this->cola.insert(this->cola.end(), C, C + p);
+    assert(this->cola.size() <= 2 * L);
+    // Byte por byte y adentro grupo por grupo: las ocurrencias salen
+    // ordenadas por su último byte
+    const unsigned char *T = this->cola.data();
+    const size_t base = this->leidos - antes; // posición en el flujo de T[0]
+    for (size_t i = antes; i < antes + p; i++)
+      for (size_t g = 0; g < this->grupos.size(); g++)
+        this->avanzar(this->grupos[g], T, i, base + i);
+    for (size_t i = p; i < len; i++)
+      for (size_t g = 0; g < this->grupos.size(); g++)
+        this->avanzar(this->grupos[g], C, i, this->leidos + i);
+    this->leidos += len;
+    if (len >= L)
+      this->cola.assign(C + len - L, C + len);
+    else
+      this->cola.erase(this->cola.begin(),
+                       this->cola.end() - std::min(L, this->cola.size()));
+  }
+
+private:
+  typedef typename H::valor valor;
+
+  struct grupo {
+    size_t largo;
+    H hash;
+    valor h_t;
+    // (hash, patrón) ordenados por hash; la tabla lleva al primero de cada hash
+    std::vector<std::pair<valor, size_t>> entradas;
+    std::vector<valor> tabla_hash;
+    std::vector<int64_t> tabla_entrada; // -1: libre
+    size_t mascara;
+
+    explicit grupo(size_t largo) : largo(largo), hash(largo) {}
+  };
+
+  std::vector<std::string> patrones;
+  callback_multi cb;
+  size_t largo_max;
+  std::vector<grupo> grupos;
+  size_t leidos;
+  std::vector<unsigned char> cola;
+
+  grupo armar_grupo(size_t largo, const std::vector<size_t> &indices) const {
+    grupo g(largo);
+    for (size_t k = 0; k < indices.size(); k++) {
+      const std::string &P = this->patrones[indices[k]];
+      valor h_p = H::vacio();
+      for (size_t i = 0; i < largo; i++)
+        h_p = g.hash.agregar(h_p, P[i]);
+      g.entradas.push_back(std::make_pair(h_p, indices[k]));
+    }
+    std::sort(g.entradas.begin(), g.entradas.end());
+
+    size_t tam = 16;
+    while (tam < 2 * g.entradas.size())
+      tam *= 2;
+    g.mascara = tam - 1;
+    g.tabla_hash.assign(tam, H::vacio());
+    g.tabla_entrada.assign(tam, -1);
+    for (size_t e = 0; e < g.entradas.size(); e++) {
+      if (e > 0 && g.entradas[e].first == g.entradas[e - 1].first)
+        continue;
+      size_t i = mezclar(H::clave(g.entradas[e].first)) & g.mascara;
+      while (g.tabla_entrada[i] != -1)
+        i = (i + 1) & g.mascara;
+      g.tabla_hash[i] = g.entradas[e].first;
+      g.tabla_entrada[i] = e;
+    }
+    return g;
+  }
+
+  // Por si los bits bajos del hash no están bien repartidos
+  static size_t mezclar(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return x;
+  }
+
+  // Mete T[i] en el hash del grupo y busca la ventana que termina ahí. Los
+  // bytes anteriores a T[i] que necesita ya están en T (la cola con el
+  // comienzo del pedazo, o el pedazo mismo).
+  void avanzar(grupo &g, const unsigned char *T, size_t i, size_t posicion) {
+    const size_t L = g.largo;
+    if (posicion >= L)
+      g.h_t = g.hash.rodar(g.h_t, T[i - L], T[i]);
+    else
+      g.h_t = g.hash.agregar(g.h_t, T[i]);
+    if (posicion + 1 >= L)
+      this->buscar(g, T + i + 1 - L, posicion + 1 - L);
+  }
+
+  void buscar(const grupo &g, const unsigned char *ventana, size_t offset) {
+    size_t i = mezclar(H::clave(g.h_t)) & g.mascara;
+    while (g.tabla_entrada[i] != -1 && g.tabla_hash[i] != g.h_t)
+      i = (i + 1) & g.mascara;
+    if (g.tabla_entrada[i] == -1)
+      return;
+    for (size_t e = g.tabla_entrada[i];
+         e < g.entradas.size() && g.entradas[e].first == g.h_t; e++) {
+      const std::string &P = this->patrones[g.entradas[e].second];
+      if (memcmp(ventana, P.data(), g.largo) == 0)
+        this->cb(offset, g.entradas[e].second);
+    }
+  }
+};
+
+// Busca todos los patrones en T (de largo n) en una pasada
+inline void rabin_karp_multi_matcher(const char *T, size_t n,
+                                     const std::vector<std::string> &patrones,
+                                     const callback_multi &cb) {
+  rabin_karp_multi<> buscador(patrones, cb);
+  buscador.feed(T, n);
+}
+
+inline bool rabin_karp_fd(int fd, const char *P, size_t m,
+                          const callback_match &cb) {
+  rabin_karp_stream<> buscador(P, m, cb);
+  return stream_fd(fd, buscador);
+}
+
+inline bool rabin_karp_file(const char *ruta, const char *P, size_t m,
+                            const callback_match &cb) {
+  rabin_karp_stream<> buscador(P, m, cb);
+  return stream_file(ruta, buscador);
+}
+
+#endif // RABIN_KARP_HPP
@@ -0,0 +1,123 @@
+#ifndef TWO_WAY_HPP
+#define TWO_WAY_HPP
+
+#include <cstddef>
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "flujo.hpp"
+
+// Two-Way (Crochemore y Perrin): corta el patrón en una factorización
+// crítica P = P[0..l] P[l+1..m-1], compara primero la parte derecha de
+// izquierda a derecha y después la izquierda de derecha a izquierda. Es
+// lineal en el peor caso y, a diferencia de Boyer-Moore o del autómata,
+// usa memoria constante además del patrón: sólo l y el período.
+class two_way {
+public:
+  two_way(const char *P, size_t m) : patron(P, m) {
+    if (m == 0)
+      return;
+    long p, q;
+    long i = sufijo_maximo(P, m, false, p);
+    long j = sufijo_maximo(P, m, true, q);
+    if (i > j) {
+      this->corte = i;
+      this->periodo = p;
+    } else {
+      this->corte = j;
+      this->periodo = q;
+    }
+    // Si P[0..corte] se repite a distancia periodo, el patrón es periódico
+    // y se recuerda cuánto del prefijo ya coincidió al correrse un período
+    this->periodico =
+        memcmp(P, P + this->periodo, this->corte + 1) == 0;
+    if (!this->periodico)
+      this->periodo = std::max(this->corte + 1, (long)m - this->corte - 1) + 1;
+  }
+
+  void buscar(const char *T, size_t n, const callback_match &cb) const {
+    const long m = this->patron.size();
+    if (m == 0 || m > (long)n)
+      return;
+    const char *P = this->patron.data();
+    const long l = this->corte;
+    const long N = n;
+    long j = 0;
+    if (this->periodico) {
+      long memoria = -1;
+      while (j <= N - m) {
+        long i = std::max(l, memoria) + 1;
+        while (i < m && P[i] == T[i + j])
+          i++;
+        if (i >= m) {
+          i = l;
+          while (i > memoria && P[i] == T[i + j])
+            i--;
+          if (i <= memoria)
+            cb(j);
+          j += this->periodo;
+          memoria = m - this->periodo - 1;
+        } else {
+          j += i - l;
+          memoria = -1;
+        }
+      }
+    } else {
+      while (j <= N - m) {
+        long i = l + 1;
+        while (i < m && P[i] == T[i + j])
+          i++;
+        if (i >= m) {
+          i = l;
+          while (i >= 0 && P[i] == T[i + j])
+            i--;
+          if (i < 0)
+            cb(j);
+          j += this->periodo;
+        } else
+          j += i - l;
+      }
+    }
+  }
+
+private:
+  std::string patron;
+  long corte;   // l: la parte izquierda es P[0..l], puede ser vacía (-1)
+  long periodo;
+  bool periodico;
+
+  // Comienzo - 1 del sufijo máximo de P para el orden de los bytes (o el
+  // inverso), y su período en p
+  static long sufijo_maximo(const char *P, size_t m, bool inverso, long &p) {
+    long ms = -1, j = 0, k = 1;
+    p = 1;
+    while (j + k < (long)m) {
+      unsigned char a = P[j + k], b = P[ms + k];
+      if (inverso ? a > b : a < b) {
+        j += k;
+        k = 1;
+        p = j - ms;
+      } else if (a == b) {
+        if (k != p)
+          k++;
+        else {
+          j += p;
+          k = 1;
+        }
+      } else {
+        ms = j;
+        j = ms + 1;
+        k = p = 1;
+      }
+    }
+    return ms;
+  }
+};
+
+inline void two_way_matcher(const char *T, size_t n, const char *P, size_t m,
+                            const callback_match &cb) {
+  two_way(P, m).buscar(T, n, cb);
+}
+
+#endif // TWO_WAY_HPP